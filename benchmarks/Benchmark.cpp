@@ -0,0 +1,207 @@
+#include "Benchmark.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <tuple>
+
+namespace
+{
+    std::atomic<size_t> allocations{ 0 };
+} // namespace
+
+#if defined( __GLIBC__ )
+// glibc lets the program replace malloc, so allocations of malloc based types like ByteArray are counted as well.
+// operator new is counted here too, as it allocates with malloc
+extern "C"
+{
+    auto __libc_malloc( size_t size ) -> void *;
+    auto __libc_calloc( size_t n, size_t size ) -> void *;
+    auto __libc_realloc( void *p, size_t size ) -> void *;
+
+    auto malloc( size_t size ) -> void *
+    {
+        allocations.fetch_add( 1, std::memory_order_relaxed );
+        return __libc_malloc( size );
+    }
+
+    auto calloc( size_t n, size_t size ) -> void *
+    {
+        allocations.fetch_add( 1, std::memory_order_relaxed );
+        return __libc_calloc( n, size );
+    }
+
+    auto realloc( void *p, size_t size ) -> void *
+    {
+        allocations.fetch_add( 1, std::memory_order_relaxed );
+        return __libc_realloc( p, size );
+    }
+}
+
+constexpr bool counts_malloc = true;
+#else
+constexpr bool counts_malloc = false;
+#endif
+
+// every heap allocation of the program goes through these, so the benchmarks can report allocation counts
+auto operator new( size_t size ) -> void *
+{
+    if constexpr ( !counts_malloc )
+        allocations.fetch_add( 1, std::memory_order_relaxed );
+    if ( auto *p = std::malloc( size == 0 ? 1 : size ) )
+        return p;
+    throw std::bad_alloc( );
+}
+
+auto operator delete( void *p ) noexcept -> void
+{
+    std::free( p );
+}
+
+auto operator delete( void *p, size_t ) noexcept -> void
+{
+    std::free( p );
+}
+
+namespace vrock::utils::bench
+{
+    auto registry( ) -> std::vector<Benchmark> &
+    {
+        static auto benchmarks = std::vector<Benchmark>( );
+        return benchmarks;
+    }
+
+    auto add( std::string name, std::string type, std::function<Case( size_t n )> setup, size_t max_n,
+              bool uses_malloc ) -> void
+    {
+        registry( ).push_back( { std::move( name ), std::move( type ), max_n, std::move( setup ), uses_malloc } );
+    }
+
+    auto allocation_count( ) -> size_t
+    {
+        return allocations.load( std::memory_order_relaxed );
+    }
+
+    auto measure( const Benchmark &b, size_t n, double min_time ) -> Result
+    {
+        using clock = std::chrono::steady_clock;
+        auto c = b.setup( n );
+        c.run( ); // warm up caches and lazily allocated state
+
+        size_t iterations = 1;
+        while ( true )
+        {
+            auto allocs = allocation_count( );
+            auto start = clock::now( );
+            for ( size_t i = 0; i < iterations; i++ )
+                c.run( );
+            auto elapsed = std::chrono::duration<double>( clock::now( ) - start ).count( );
+            allocs = allocation_count( ) - allocs;
+            if ( elapsed >= min_time || iterations >= ( size_t( 1 ) << 30 ) )
+            {
+                auto res = Result( );
+                res.name = b.name;
+                res.type = b.type;
+                res.n = n;
+                res.iterations = iterations;
+                res.ns_per_element = elapsed * 1e9 / static_cast<double>( iterations ) / static_cast<double>( n );
+                res.bytes_per_second = static_cast<double>( c.bytes ) * static_cast<double>( iterations ) / elapsed;
+                res.allocations = b.uses_malloc && !counts_malloc
+                                      ? -1.0
+                                      : static_cast<double>( allocs ) / static_cast<double>( iterations );
+                return res;
+            }
+            // aim for min_time in the next round, but at least double the iterations
+            auto target = elapsed > 0 ? min_time / elapsed * 1.2 * static_cast<double>( iterations ) : 0.0;
+            iterations = std::max( iterations * 2, static_cast<size_t>( target ) );
+        }
+    }
+
+    auto to_json( const std::vector<Result> &results ) -> std::string
+    {
+        auto out = std::ostringstream( );
+        out << "{\n  \"benchmarks\": [\n";
+        for ( size_t i = 0; i < results.size( ); i++ )
+        {
+            const auto &r = results[ i ];
+            char line[ 512 ];
+            std::snprintf( line, sizeof( line ),
+                           "    { \"name\": \"%s\", \"type\": \"%s\", \"n\": %zu, \"iterations\": %zu, "
+                           "\"ns_per_element\": %.4f, \"bytes_per_second\": %.1f, \"allocations\": %.2f }%s\n",
+                           r.name.c_str( ), r.type.c_str( ), r.n, r.iterations, r.ns_per_element, r.bytes_per_second,
+                           r.allocations, i + 1 < results.size( ) ? "," : "" );
+            out << line;
+        }
+        out << "  ]\n}\n";
+        return out.str( );
+    }
+
+    namespace
+    {
+        auto field( const std::string &line, const std::string &key ) -> std::string
+        {
+            auto pos = line.find( "\"" + key + "\":" );
+            if ( pos == std::string::npos )
+                return "";
+            pos = line.find_first_not_of( ' ', pos + key.size( ) + 3 );
+            if ( line[ pos ] == '"' )
+                return line.substr( pos + 1, line.find( '"', pos + 1 ) - pos - 1 );
+            return line.substr( pos, line.find_first_of( ",}", pos ) - pos );
+        }
+    } // namespace
+
+    auto from_json( const std::string &json ) -> std::vector<Result>
+    {
+        auto results = std::vector<Result>( );
+        auto in = std::istringstream( json );
+        for ( std::string line; std::getline( in, line ); )
+        {
+            if ( line.find( "\"name\":" ) == std::string::npos )
+                continue;
+            auto r = Result( );
+            r.name = field( line, "name" );
+            r.type = field( line, "type" );
+            r.n = std::stoull( field( line, "n" ) );
+            r.iterations = std::stoull( field( line, "iterations" ) );
+            r.ns_per_element = std::stod( field( line, "ns_per_element" ) );
+            r.bytes_per_second = std::stod( field( line, "bytes_per_second" ) );
+            r.allocations = std::stod( field( line, "allocations" ) );
+            results.push_back( std::move( r ) );
+        }
+        return results;
+    }
+
+    auto compare( const std::vector<Result> &baseline, const std::vector<Result> &results, double threshold )
+        -> size_t
+    {
+        auto base = std::map<std::tuple<std::string, std::string, size_t>, const Result *>( );
+        for ( const auto &r : baseline )
+            base[ { r.name, r.type, r.n } ] = &r;
+
+        size_t regressions = 0;
+        for ( const auto &r : results )
+        {
+            auto it = base.find( { r.name, r.type, r.n } );
+            if ( it == base.end( ) )
+                continue;
+            const auto &b = *it->second;
+            auto ratio = b.ns_per_element > 0 ? r.ns_per_element / b.ns_per_element : 1.0;
+            bool slower = ratio > 1.0 + threshold;
+            // -1 marks allocation counts that could not be measured on this platform
+            bool allocates = r.allocations >= 0 && b.allocations >= 0 && r.allocations > b.allocations + 0.5;
+            if ( slower || allocates )
+                regressions++;
+            char line[ 256 ];
+            std::snprintf( line, sizeof( line ), "%-40s %-8s %9zu %+8.1f%%  allocs %8.1f -> %-8.1f %s\n",
+                           r.name.c_str( ), r.type.c_str( ), r.n, ( ratio - 1.0 ) * 100.0, b.allocations,
+                           r.allocations, slower || allocates ? "REGRESSION" : "" );
+            std::cerr << line;
+        }
+        return regressions;
+    }
+} // namespace vrock::utils::bench
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace vrock::utils::bench
+{
+    /// input sizes every benchmark is run with, limited by Benchmark::max_n and --max-size
+    inline const std::vector<size_t> sizes = { 100, 1000, 10000, 100000, 1000000, 10000000 };
+
+    /// one prepared run of a benchmark for a given size
+    struct Case
+    {
+        /// the measured operation, called repeatedly
+        std::function<void( )> run;
+        /// bytes of input processed by one call of run
+        size_t bytes;
+    };
+
+    /// an operation benchmarked for one element type over all sizes
+    struct Benchmark
+    {
+        std::string name;
+        std::string type;
+        /// largest size to run, used to keep quadratic operators at reasonable run times
+        size_t max_n;
+        /// builds the input for n elements outside of the measurement
+        std::function<Case( size_t n )> setup;
+        /// true if the operation allocates with malloc instead of operator new
+        bool uses_malloc = false;
+    };
+
+    /// measured result of one Benchmark and size
+    struct Result
+    {
+        std::string name;
+        std::string type;
+        size_t n = 0;
+        size_t iterations = 0;
+        double ns_per_element = 0;
+        double bytes_per_second = 0;
+        /// heap allocations per run, -1 if they could not be counted (malloc based cases on platforms other than
+        /// glibc)
+        double allocations = 0;
+    };
+
+    /// all registered benchmarks
+    auto registry( ) -> std::vector<Benchmark> &;
+
+    /// registers a benchmark
+    auto add( std::string name, std::string type, std::function<Case( size_t n )> setup, size_t max_n = 10000000,
+              bool uses_malloc = false ) -> void;
+
+    /// @return amount of heap allocations (operator new, and malloc with glibc) since the start of the program
+    auto allocation_count( ) -> size_t;
+
+    /// keeps the compiler from optimizing away the computation of v
+    template <class T> inline auto do_not_optimize( const T &v ) -> void
+    {
+#if defined( _MSC_VER )
+        static volatile const void *sink;
+        sink = &v;
+#else
+        asm volatile( "" : : "r,m"( v ) : "memory" );
+#endif
+    }
+
+    /// @brief runs a benchmark for one size. the operation is repeated until min_time seconds are spent
+    auto measure( const Benchmark &b, size_t n, double min_time ) -> Result;
+
+    /// @return the results as JSON, one benchmark per line
+    auto to_json( const std::vector<Result> &results ) -> std::string;
+    /// @return results read from JSON written by to_json
+    auto from_json( const std::string &json ) -> std::vector<Result>;
+
+    /// @brief compares results against a baseline and prints every case. a case regressed if it is more than
+    /// threshold slower per element or allocates more
+    /// @return amount of regressions
+    auto compare( const std::vector<Result> &baseline, const std::vector<Result> &results, double threshold )
+        -> size_t;
+
+    /// registers the List benchmarks
+    auto register_list_benchmarks( ) -> void;
+    /// registers the ByteArray benchmarks
+    auto register_byte_array_benchmarks( ) -> void;
+} // namespace vrock::utils::bench
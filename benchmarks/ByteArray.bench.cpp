@@ -0,0 +1,72 @@
+#include "Benchmark.hpp"
+
+#include <vrock/utils/ByteArray.hpp>
+
+#include <memory>
+#include <string>
+
+using vrock::utils::ByteArray;
+
+namespace vrock::utils::bench
+{
+    namespace
+    {
+        auto text( size_t n ) -> std::string
+        {
+            auto s = std::string( n, ' ' );
+            for ( size_t i = 0; i < n; i++ )
+                s[ i ] = static_cast<char>( 'a' + i * 7 % 26 );
+            return s;
+        }
+
+        template <class F> auto add_bytes( const char *name, F setup ) -> void
+        {
+            add( std::string( "ByteArray::" ) + name, "bytes", setup, 10000000, true );
+        }
+    } // namespace
+
+    auto register_byte_array_benchmarks( ) -> void
+    {
+        add_bytes( "ByteArray(len)", []( size_t n ) {
+            return Case{ [ n ]( ) { do_not_optimize( ByteArray( n ).data ); }, n };
+        } );
+        add_bytes( "from_string", []( size_t n ) {
+            auto s = text( n );
+            return Case{ [ s ]( ) { do_not_optimize( ByteArray::from_string( s ) ); }, n };
+        } );
+        add_bytes( "to_string", []( size_t n ) {
+            auto a = ByteArray::from_string( text( n ) );
+            return Case{ [ a ]( ) { do_not_optimize( a->to_string( ) ); }, n };
+        } );
+        add_bytes( "from_hex_string", []( size_t n ) {
+            auto hex = ByteArray::from_string( text( n ) )->to_hex_string( );
+            return Case{ [ hex ]( ) { do_not_optimize( ByteArray::from_hex_string( hex ) ); }, hex.size( ) };
+        } );
+        add_bytes( "to_hex_string", []( size_t n ) {
+            auto a = ByteArray::from_string( text( n ) );
+            return Case{ [ a ]( ) { do_not_optimize( a->to_hex_string( ) ); }, n };
+        } );
+        add_bytes( "subarr", []( size_t n ) {
+            auto a = ByteArray::from_string( text( n ) );
+            return Case{ [ a, n ]( ) { do_not_optimize( a->subarr( n / 4, n / 2 ) ); }, n / 2 };
+        } );
+        add_bytes( "append", []( size_t n ) {
+            auto half = ByteArray::from_string( text( n / 2 ) );
+            return Case{ [ half ]( ) {
+                            auto a = ByteArray::from_string( half->to_string( ) );
+                            a->append( half );
+                            do_not_optimize( a->data );
+                        },
+                         n };
+        } );
+        add_bytes( "get/set", []( size_t n ) {
+            auto a = ByteArray::from_string( text( n ) );
+            return Case{ [ a ]( ) {
+                            for ( size_t i = 0; i < a->length; i++ )
+                                a->set( i, a->get( i ) + 1 );
+                            do_not_optimize( a->data[ 0 ] );
+                        },
+                         n };
+        } );
+    }
+} // namespace vrock::utils::bench
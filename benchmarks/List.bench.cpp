@@ -0,0 +1,230 @@
+#include "Benchmark.hpp"
+
+#include <vrock/utils/List.hpp>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+
+using vrock::utils::List;
+
+namespace vrock::utils::bench
+{
+    namespace
+    {
+        struct Record
+        {
+            int id{ };
+            double value{ };
+            std::string name;
+
+            friend bool operator==( const Record &lhs, const Record &rhs )
+            {
+                return lhs.id == rhs.id && lhs.value == rhs.value && lhs.name == rhs.name;
+            }
+        };
+
+        /// quadratic operators are only run up to this size
+        constexpr size_t quadratic_n = 10000;
+
+        /// random elements with roughly n / 2 distinct values
+        template <class T> auto generate( size_t n ) -> List<T>
+        {
+            auto rng = std::mt19937_64( 42 );
+            auto dist = std::uniform_int_distribution<int>( 0, static_cast<int>( std::max<size_t>( 1, n / 2 ) ) );
+            auto ret = List<T>( );
+            ret.reserve( n );
+            for ( size_t i = 0; i < n; i++ )
+            {
+                int v = dist( rng );
+                if constexpr ( std::is_same_v<T, int> )
+                    ret.push_back( v );
+                else if constexpr ( std::is_same_v<T, double> )
+                    ret.push_back( v * 0.5 );
+                else if constexpr ( std::is_same_v<T, std::string> )
+                    ret.push_back( "key-" + std::to_string( v ) );
+                else
+                    ret.push_back( Record{ v, v * 0.5, "name-" + std::to_string( v ) } );
+            }
+            return ret;
+        }
+
+        template <class T> auto payload( const List<T> &l ) -> size_t
+        {
+            size_t bytes = l.size( ) * sizeof( T );
+            if constexpr ( std::is_same_v<T, std::string> )
+                for ( const auto &s : l )
+                    bytes += s.size( );
+            else if constexpr ( std::is_same_v<T, Record> )
+                for ( const auto &r : l )
+                    bytes += r.name.size( );
+            return bytes;
+        }
+
+        /// key used for joins, ordering and lookups
+        template <class T> auto key( const T &e )
+        {
+            if constexpr ( std::is_same_v<T, Record> )
+                return e.id;
+            else
+                return e;
+        }
+
+        /// key with a small amount of distinct values, used for grouping
+        template <class T> auto group( const T &e ) -> int
+        {
+            if constexpr ( std::is_same_v<T, std::string> )
+                return e.back( );
+            else
+                return static_cast<int>( key( e ) ) % 64;
+        }
+
+        /// predicate that holds for about half of the elements
+        template <class T> auto pred( const T &e ) -> bool
+        {
+            return group( e ) % 2 == 0;
+        }
+
+        template <class T> auto type_name( ) -> std::string
+        {
+            if constexpr ( std::is_same_v<T, int> )
+                return "int";
+            else if constexpr ( std::is_same_v<T, double> )
+                return "double";
+            else if constexpr ( std::is_same_v<T, std::string> )
+                return "string";
+            else
+                return "struct";
+        }
+
+        /// registers List::op for T. body takes the input List and returns the result
+        template <class T, class F> auto add_list( const char *op, F body, size_t max_n = 10000000 ) -> void
+        {
+            add(
+                std::string( "List::" ) + op, type_name<T>( ),
+                [ body ]( size_t n ) {
+                    auto l = std::make_shared<const List<T>>( generate<T>( n ) );
+                    return Case{ [ l, body ]( ) {
+                                    if constexpr ( std::is_void_v<std::invoke_result_t<F, const List<T> &>> )
+                                        body( *l );
+                                    else
+                                        do_not_optimize( body( *l ) );
+                                },
+                                 payload( *l ) };
+                },
+                max_n );
+        }
+
+        template <class T> auto register_type( ) -> void
+        {
+            using L = List<T>;
+            auto p = []( T e ) { return pred( e ); };
+            auto k = []( const T &e ) { return key( e ); };
+            auto g = []( const T &e ) { return group( e ); };
+            auto pair = []( const T &a, const T &b ) { return key( a ) == key( b ); };
+
+            add_list<T>( "copy", []( const L &l ) { return L( l ); } );
+            add_list<T>( "for_each", []( const L &l ) {
+                size_t c = 0;
+                l.for_each( [ & ]( T e ) { c += pred( e ); } );
+                return c;
+            } );
+            add_list<T>( "aggregate", []( const L &l ) {
+                return l.template aggregate<size_t>( []( T e, size_t c ) { return c + pred( e ); } );
+            } );
+            add_list<T>( "count(pred)", [ p ]( const L &l ) { return l.count( p ); } );
+            add_list<T>( "contains", []( const L &l ) { return l.contains( T( ) ); } );
+            add_list<T>( "any", []( const L &l ) { return l.any( []( T e ) { return !pred( e ) && pred( e ); } ); } );
+            add_list<T>( "all", []( const L &l ) { return l.all( []( T ) { return true; } ); } );
+            add_list<T>( "first", [ p ]( const L &l ) { return l.first_or_default( p ); } );
+            add_list<T>( "last", [ p ]( const L &l ) { return l.last_or_default( p ); } );
+            add_list<T>( "sequence_equal", []( const L &l ) { return l.sequence_equal( l ); } );
+            add_list<T>( "concat", []( const L &l ) { return L( l ).concat( l ); } );
+            add_list<T>( "skip", []( const L &l ) { return l.skip( l.size( ) / 2 ); } );
+            add_list<T>( "take", []( const L &l ) { return l.take( l.size( ) / 2 ); } );
+            add_list<T>( "skip_while", []( const L &l ) { return l.skip_while( []( T ) { return true; } ); } );
+            add_list<T>( "take_while", []( const L &l ) { return l.take_while( []( T ) { return true; } ); } );
+            add_list<T>( "revers", []( const L &l ) { return L( l ).revers( ); } );
+            add_list<T>( "select",
+                         []( const L &l ) { return l.template select<int>( []( T e ) { return group( e ); } ); } );
+            add_list<T>( "where", [ p ]( const L &l ) { return l.where( p ); } );
+            add_list<T>( "where_inplace", [ p ]( const L &l ) { return std::move( L( l ).where_inplace( p ) ); } );
+            add_list<T>( "join", [ k ]( const L &l ) {
+                return l.join( l, k, k, []( const T &a, const T & ) { return group( a ); } );
+            } );
+            add_list<T>(
+                "join(predicate)",
+                [ pair ]( const L &l ) {
+                    return l.template join<T, int>( l, pair, []( T a, T ) { return group( a ); } );
+                },
+                1000 );
+            add_list<T>( "left_join", [ k ]( const L &l ) {
+                return l.left_join( l, k, k, []( const T &a, const T * ) { return group( a ); } );
+            } );
+            add_list<T>( "outer_join", [ k ]( const L &l ) {
+                return l.outer_join( l, k, k, []( const T *, const T * ) { return 0; } );
+            } );
+            add_list<T>( "semi_join", [ k ]( const L &l ) { return l.semi_join( l, k, k ); } );
+            add_list<T>( "anti_join", [ k ]( const L &l ) { return l.anti_join( l, k, k ); } );
+            add_list<T>( "group_join", [ k ]( const L &l ) {
+                return l.group_join( l, k, k, []( const T &, const L &m ) { return m.size( ); } );
+            } );
+            add_list<T>( "merge_join", [ k ]( const L &l ) {
+                auto sorted = l.order_by( k ).to_list( );
+                return sorted.merge_join( sorted, k, k, []( const T &a, const T & ) { return group( a ); } );
+            } );
+            add_list<T>( "group_by", [ g ]( const L &l ) { return l.group_by( g ).size( ); } );
+            add_list<T>( "unordered_group_by", [ g ]( const L &l ) { return l.unordered_group_by( g ).size( ); } );
+            add_list<T>( "group_count", [ g ]( const L &l ) { return l.group_count( g ).size( ); } );
+            add_list<T>( "group_min", [ g ]( const L &l ) { return l.group_min( g, g ).size( ); } );
+            add_list<T>( "order_by(comparator)", []( const L &l ) {
+                return L( l ).order_by( []( T a, T b ) { return key( a ) < key( b ); } );
+            } );
+            add_list<T>( "order_by(key)", [ k ]( const L &l ) { return l.order_by( k ).to_list( ); } );
+            add_list<T>( "order_by(key).stable", [ k ]( const L &l ) { return l.order_by( k ).stable( ).to_list( ); } );
+            add_list<T>( "order_by(key).take", [ k ]( const L &l ) { return l.order_by( k ).take( 10 ); } );
+            add_list<T>( "min_by", [ k ]( const L &l ) { return l.min_by( k ); } );
+            add_list<T>( "max_by", [ k ]( const L &l ) { return l.max_by( k ); } );
+            add_list<T>( "distinct", []( const L &l ) { return l.distinct( ); }, quadratic_n );
+            add_list<T>( "union_list", []( const L &l ) { return l.union_list( l ); }, quadratic_n );
+            add_list<T>( "intersect", []( const L &l ) { return l.intersect( l ); }, quadratic_n );
+            add_list<T>( "except", []( const L &l ) { return l.except( l ); }, quadratic_n );
+            add_list<T>( "index_by", [ k ]( const L &l ) {
+                auto index = l.index_by( k );
+                size_t c = 0;
+                for ( const auto &e : l )
+                    c += index.count( key( e ) );
+                return c;
+            } );
+            add_list<T>( "to_vector", []( const L &l ) { return l.to_vector( ); } );
+
+            if constexpr ( std::is_arithmetic_v<T> )
+            {
+                add_list<T>( "sum", []( const L &l ) { return l.sum( ); } );
+                add_list<T>( "average", []( const L &l ) { return l.average( ); } );
+                add_list<T>( "min", []( const L &l ) { return l.min( ); } );
+                add_list<T>( "max", []( const L &l ) { return l.max( ); } );
+                add_list<T>( "where_less", []( const L &l ) { return l.where_less( T( 100 ) ); } );
+                add_list<T>( "where_between", []( const L &l ) { return l.where_between( T( 10 ), T( 1000 ) ); } );
+            }
+        }
+    } // namespace
+
+    auto register_list_benchmarks( ) -> void
+    {
+        register_type<int>( );
+        register_type<double>( );
+        register_type<std::string>( );
+        register_type<Record>( );
+
+        add(
+            "select_many", "int",
+            []( size_t n ) {
+                auto l = std::make_shared<List<List<int>>>( );
+                for ( size_t i = 0; i < n; i += 100 )
+                    l->push_back( generate<int>( std::min<size_t>( 100, n - i ) ) );
+                return Case{ [ l ]( ) { do_not_optimize( vrock::utils::select_many( *l ) ); }, n * sizeof( int ) };
+            } );
+    }
+} // namespace vrock::utils::bench
@@ -0,0 +1,102 @@
+#include "Benchmark.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace vrock::utils::bench;
+
+static auto usage( ) -> void
+{
+    std::cerr << "usage: benchmarks [options]\n"
+                 "  --filter <text>       only run benchmarks whose name or type contains text\n"
+                 "  --max-size <n>        largest input size, default 1000000\n"
+                 "  --min-time <seconds>  minimal measured time per case, default 0.1\n"
+                 "  --out <file>          write the JSON results to file instead of stdout\n"
+                 "  --compare <file>      compare against a baseline written with --out\n"
+                 "  --threshold <ratio>   slowdown per element that counts as regression, default 0.1\n";
+}
+
+static auto read_file( const std::string &path ) -> std::string
+{
+    auto in = std::ifstream( path );
+    if ( !in )
+        throw std::runtime_error( "failed to open " + path );
+    auto ss = std::stringstream( );
+    ss << in.rdbuf( );
+    return ss.str( );
+}
+
+int main( int argc, char **argv )
+{
+    std::string filter, out, baseline;
+    size_t max_size = 1000000;
+    double min_time = 0.1, threshold = 0.1;
+    try
+    {
+        for ( int i = 1; i < argc; i++ )
+        {
+            auto arg = std::string( argv[ i ] );
+            if ( arg == "--help" || arg == "-h" )
+            {
+                usage( );
+                return 0;
+            }
+            if ( i + 1 >= argc )
+                throw std::invalid_argument( "missing value for " + arg );
+            auto value = std::string( argv[ ++i ] );
+            if ( arg == "--filter" )
+                filter = value;
+            else if ( arg == "--max-size" )
+                max_size = std::stoull( value );
+            else if ( arg == "--min-time" )
+                min_time = std::stod( value );
+            else if ( arg == "--out" )
+                out = value;
+            else if ( arg == "--compare" )
+                baseline = value;
+            else if ( arg == "--threshold" )
+                threshold = std::stod( value );
+            else
+                throw std::invalid_argument( "unknown option " + arg );
+        }
+
+        register_list_benchmarks( );
+        register_byte_array_benchmarks( );
+
+        auto results = std::vector<Result>( );
+        for ( const auto &b : registry( ) )
+        {
+            if ( !filter.empty( ) && ( b.name + " " + b.type ).find( filter ) == std::string::npos )
+                continue;
+            for ( auto n : sizes )
+            {
+                if ( n > max_size || n > b.max_n )
+                    break;
+                std::cerr << b.name << " " << b.type << " " << n << std::endl;
+                results.push_back( measure( b, n, min_time ) );
+            }
+        }
+
+        auto json = to_json( results );
+        if ( out.empty( ) )
+            std::cout << json;
+        else
+            std::ofstream( out ) << json;
+
+        if ( !baseline.empty( ) )
+        {
+            auto regressions = compare( from_json( read_file( baseline ) ), results, threshold );
+            std::cerr << regressions << " regression(s)" << std::endl;
+            return regressions == 0 ? 0 : 1;
+        }
+    }
+    catch ( const std::exception &e )
+    {
+        std::cerr << e.what( ) << std::endl;
+        usage( );
+        return 2;
+    }
+    return 0;
+}
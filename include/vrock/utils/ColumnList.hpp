@@ -0,0 +1,232 @@
+#pragma once
+
+#include "List.hpp"
+
+#include <cstddef>
+#include <map>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vrock::utils
+{
+    /*! \cond */
+    namespace detail
+    {
+        template <class M> struct member_type;
+
+        template <class C, class V> struct member_type<V C::*>
+        {
+            using type = V;
+        };
+
+        template <auto A, auto B> constexpr auto same_member( ) -> bool
+        {
+            if constexpr ( std::is_same_v<decltype( A ), decltype( B )> )
+                return A == B;
+            else
+                return false;
+        }
+    } // namespace detail
+    /*! \endcond */
+
+    /// List that stores every registered member of T in its own contiguous column (structure of arrays).
+    ///
+    /// Scans over a single member only touch that member's column. Column scans produce selection vectors (positions
+    /// of the matching rows) which can be refined by further scans and gathered into a new ColumnList or List.
+    /// Only the registered members survive the round trip to and from List<T>, all other members are default
+    /// initialized.
+    /// @tparam T record type, has to be default constructible
+    /// @tparam Members member pointers of T that are stored as columns
+    template <class T, auto... Members> class ColumnList
+    {
+    public:
+        /// positions of selected rows, in ascending order
+        using selection = std::vector<size_t>;
+        /// type of the column of member M
+        template <auto M> using column_type = typename detail::member_type<decltype( M )>::type;
+
+        /// Empty list
+        ColumnList( )
+        {
+        }
+        /// @param list records to split into columns
+        explicit ColumnList( const List<T> &list )
+        {
+            reserve( list.size( ) );
+            for ( const auto &e : list )
+                push_back( e );
+        }
+
+    public:
+        /// @return amount of rows
+        auto inline count( ) const -> size_t
+        {
+            return std::get<0>( columns ).size( );
+        }
+        /// allocates memory for len rows in every column
+        auto inline reserve( size_t len ) -> void
+        {
+            std::apply( [ len ]( auto &...c ) { ( c.reserve( len ), ... ); }, columns );
+        }
+        /// appends the registered members of e
+        auto inline push_back( const T &e ) -> void
+        {
+            push_back_impl( e, std::index_sequence_for<decltype( Members )...>( ) );
+        }
+        /// @param i row position
+        /// @return row i reassembled as T
+        auto inline at( size_t i ) const -> T
+        {
+            T ret = T( );
+            assign_row( ret, i, std::index_sequence_for<decltype( Members )...>( ) );
+            return ret;
+        }
+        /// @return column of member M
+        template <auto M> auto inline column( ) const -> const std::vector<column_type<M>> &
+        {
+            static_assert( index_of<M>( ) < sizeof...( Members ), "member is not a column of this ColumnList" );
+            return std::get<index_of<M>( )>( columns );
+        }
+        /// scans the column of M and returns the positions of all rows whose value complies with the expression
+        /// @param exp expression that takes a value of the column
+        /// @return selection vector
+        template <auto M, class P> auto inline scan( P exp ) const -> selection
+        {
+            const auto &c = column<M>( );
+            auto ret = selection( );
+            for ( size_t i = 0; i < c.size( ); i++ )
+                if ( exp( c[ i ] ) )
+                    ret.push_back( i );
+            return ret;
+        }
+        /// refines a selection by scanning only the selected rows of the column of M
+        /// @param sel selection to refine
+        /// @param exp expression that takes a value of the column
+        /// @return selection vector containing the rows of sel that comply with the expression
+        template <auto M, class P> auto inline scan( const selection &sel, P exp ) const -> selection
+        {
+            const auto &c = column<M>( );
+            auto ret = selection( );
+            for ( auto i : sel )
+                if ( exp( c[ i ] ) )
+                    ret.push_back( i );
+            return ret;
+        }
+        /// @brief gathers the selected rows of all columns
+        /// @param sel selection vector
+        /// @return ColumnList containing the selected rows
+        auto inline gather( const selection &sel ) const -> ColumnList
+        {
+            auto ret = ColumnList( );
+            std::apply(
+                [ & ]( auto &...dst ) {
+                    std::apply( [ & ]( const auto &...src ) { ( gather_column( dst, src, sel ), ... ); }, columns );
+                },
+                ret.columns );
+            return ret;
+        }
+        /// @brief apply a filter on the column of M
+        /// @param exp expression that takes a value of the column
+        /// @return ColumnList with all rows complying to the expression
+        template <auto M, class P> auto inline where( P exp ) const -> ColumnList
+        {
+            return gather( scan<M>( exp ) );
+        }
+        /// @return the column of M as List
+        template <auto M> auto inline select( ) const -> List<column_type<M>>
+        {
+            return List<column_type<M>>( column<M>( ) );
+        }
+        /// @param sel selection vector
+        /// @return the selected values of the column of M
+        template <auto M> auto inline select( const selection &sel ) const -> List<column_type<M>>
+        {
+            auto ret = List<column_type<M>>( );
+            gather_column( ret, column<M>( ), sel );
+            return ret;
+        }
+        /// applies an aggregate function on the column of M
+        /// @param exp aggregate function to use. it takes the column value and the value of the runs before. returns
+        /// the new value
+        /// @return result after the aggregate function was run on every value
+        template <auto M, class R, class F> auto inline aggregate( F exp ) const -> R
+        {
+            R ret = R( );
+            for ( const auto &v : column<M>( ) )
+                ret = exp( v, std::move( ret ) );
+            return ret;
+        }
+        /// @brief groups the rows by the column of K, the groups are ordered by their key
+        /// @return map from key to the selection of rows with that key
+        template <auto K> auto inline group_by( ) const
+        {
+            const auto &keys = column<K>( );
+            auto comp = []( const column_type<K> &a, const column_type<K> &b ) { return less( a, b ); };
+            auto res = std::map<column_type<K>, selection, decltype( comp )>( comp );
+            for ( size_t i = 0; i < keys.size( ); i++ )
+                res[ keys[ i ] ].push_back( i );
+            return res;
+        }
+        /// @brief folds the column of V per key of the column of K in one pass
+        /// @param init start value of every group
+        /// @param exp aggregate function. it takes the value and the value of the group so far and returns the new
+        /// value
+        /// @return hash map from key to the aggregated value
+        template <auto K, auto V, class A, class F> auto inline group_aggregate( A init, F exp ) const
+        {
+            const auto &keys = column<K>( );
+            const auto &values = column<V>( );
+            auto res = std::unordered_map<column_type<K>, A, detail::key_hash<column_type<K>>>( );
+            for ( size_t i = 0; i < keys.size( ); i++ )
+            {
+                auto it = res.try_emplace( keys[ i ], init ).first;
+                it->second = exp( values[ i ], std::move( it->second ) );
+            }
+            return res;
+        }
+        /// @return all rows reassembled as List<T>
+        auto inline to_list( ) const -> List<T>
+        {
+            auto ret = List<T>( std::vector<T>( count( ) ) );
+            for ( size_t i = 0; i < ret.size( ); i++ )
+                assign_row( ret[ i ], i, std::index_sequence_for<decltype( Members )...>( ) );
+            return ret;
+        }
+
+    private:
+        /*! \cond */
+        template <auto M> static constexpr auto index_of( ) -> size_t
+        {
+            constexpr bool matches[] = { detail::same_member<M, Members>( )... };
+            for ( size_t i = 0; i < sizeof...( Members ); i++ )
+                if ( matches[ i ] )
+                    return i;
+            return sizeof...( Members );
+        }
+
+        template <size_t... I> auto push_back_impl( const T &e, std::index_sequence<I...> ) -> void
+        {
+            ( std::get<I>( columns ).push_back( e.*Members ), ... );
+        }
+
+        template <size_t... I> auto assign_row( T &e, size_t i, std::index_sequence<I...> ) const -> void
+        {
+            ( ( e.*Members = std::get<I>( columns )[ i ] ), ... );
+        }
+
+        template <class D, class S> static auto gather_column( D &dst, const S &src, const selection &sel ) -> void
+        {
+            dst.reserve( sel.size( ) );
+            for ( auto i : sel )
+                dst.push_back( src[ i ] );
+        }
+        /*! \endcond */
+
+        std::tuple<std::vector<column_type<Members>>...> columns;
+
+        static_assert( sizeof...( Members ) > 0, "ColumnList needs at least one column" );
+    };
+} // namespace vrock::utils
@@ -0,0 +1,609 @@
+#pragma once
+
+#include "ByteArray.hpp"
+#include "List.hpp"
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace vrock::utils
+{
+    /// default amount of elements per batch of an Enumerable
+    constexpr size_t default_batch_size = 1024;
+    /// default size of the chunks read by read_chunks
+    constexpr size_t default_chunk_size = 64 * 1024;
+
+    /// Lazy, single pass stream of elements backed by a coroutine.
+    ///
+    /// The coroutine produces the elements in batches (List<T>), so at most one batch per stage of a pipeline is held
+    /// in memory. The operators where, select, take and skip consume this Enumerable and return a new one, the
+    /// terminal operations (for_each, aggregate, group_by, to_list, ...) pull the whole stream in one pass.
+    /// @tparam T type of the elements
+    template <class T> class Enumerable
+    {
+    public:
+        /*! \cond */
+        struct promise_type
+        {
+            List<T> batch;
+            std::exception_ptr error;
+
+            auto get_return_object( ) -> Enumerable
+            {
+                return Enumerable( std::coroutine_handle<promise_type>::from_promise( *this ) );
+            }
+            auto initial_suspend( ) noexcept -> std::suspend_always
+            {
+                return { };
+            }
+            auto final_suspend( ) noexcept -> std::suspend_always
+            {
+                return { };
+            }
+            auto yield_value( List<T> &&b ) noexcept -> std::suspend_always
+            {
+                batch = std::move( b );
+                return { };
+            }
+            auto yield_value( const List<T> &b ) -> std::suspend_always
+            {
+                batch = b;
+                return { };
+            }
+            auto return_void( ) noexcept -> void
+            {
+            }
+            auto unhandled_exception( ) -> void
+            {
+                error = std::current_exception( );
+            }
+        };
+        /*! \endcond */
+
+        /// input iterator over the elements of the stream
+        class iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T *;
+            using reference = T &;
+
+            iterator( ) = default;
+            explicit iterator( Enumerable *e ) : e( e )
+            {
+                if ( !e->next_batch( ) )
+                    this->e = nullptr;
+            }
+
+            auto operator*( ) const -> T &
+            {
+                return e->coroutine.promise( ).batch[ i ];
+            }
+            auto operator->( ) const -> T *
+            {
+                return &e->coroutine.promise( ).batch[ i ];
+            }
+            auto operator++( ) -> iterator &
+            {
+                if ( ++i >= e->coroutine.promise( ).batch.size( ) )
+                {
+                    i = 0;
+                    if ( !e->next_batch( ) )
+                        e = nullptr;
+                }
+                return *this;
+            }
+            auto operator++( int ) -> void
+            {
+                ++*this;
+            }
+            friend auto operator==( const iterator &a, const iterator &b ) -> bool
+            {
+                return a.e == b.e && ( a.e == nullptr || a.i == b.i );
+            }
+
+        private:
+            Enumerable *e = nullptr;
+            size_t i = 0;
+        };
+
+        explicit Enumerable( std::coroutine_handle<promise_type> coroutine, size_t batch_size = default_batch_size )
+            : coroutine( coroutine ), batch_size( batch_size )
+        {
+        }
+        Enumerable( const Enumerable & ) = delete;
+        Enumerable( Enumerable &&o ) noexcept
+            : coroutine( std::exchange( o.coroutine, nullptr ) ), batch_size( o.batch_size )
+        {
+        }
+        auto operator=( const Enumerable & ) -> Enumerable & = delete;
+        auto operator=( Enumerable &&o ) noexcept -> Enumerable &
+        {
+            if ( this != &o )
+            {
+                if ( coroutine )
+                    coroutine.destroy( );
+                coroutine = std::exchange( o.coroutine, nullptr );
+                batch_size = o.batch_size;
+            }
+            return *this;
+        }
+        ~Enumerable( )
+        {
+            if ( coroutine )
+                coroutine.destroy( );
+        }
+
+    public:
+        /// @return iterator to the first element, starts pulling the stream
+        auto begin( ) -> iterator
+        {
+            return iterator( this );
+        }
+        /// @return end of the stream
+        auto end( ) -> iterator
+        {
+            return iterator( );
+        }
+        /// @brief resumes the coroutine until it yields the next non empty batch. rethrows exceptions of the
+        /// coroutine
+        /// @return the next batch or nullptr if the stream is exhausted. the batch is valid until the next call
+        auto next_batch( ) -> List<T> *
+        {
+            while ( coroutine && !coroutine.done( ) )
+            {
+                coroutine.promise( ).batch.clear( );
+                coroutine.resume( );
+                if ( auto error = coroutine.promise( ).error )
+                {
+                    coroutine.promise( ).error = nullptr;
+                    std::rethrow_exception( error );
+                }
+                if ( !coroutine.done( ) && !coroutine.promise( ).batch.empty( ) )
+                    return &coroutine.promise( ).batch;
+            }
+            return nullptr;
+        }
+        /// @return amount of elements the operators put into one batch
+        auto get_batch_size( ) const -> size_t
+        {
+            return batch_size;
+        }
+
+        /// @brief filters the stream, consumes this Enumerable
+        /// @param exp expression to decide if an element should be in the resulting stream
+        template <class P> auto where( P exp ) && -> Enumerable<T>
+        {
+            auto size = batch_size;
+            return with_batch_size( where_impl( std::move( *this ), std::move( exp ), size ), size );
+        }
+        /// @brief applies an expression on every element, consumes this Enumerable
+        /// @param exp expression which takes an element of type T and returns the new element
+        template <class F> auto select( F exp ) && -> Enumerable<std::decay_t<std::invoke_result_t<F &, T &>>>
+        {
+            using R = std::decay_t<std::invoke_result_t<F &, T &>>;
+            auto size = batch_size;
+            return Enumerable<R>::with_batch_size( select_impl<R>( std::move( *this ), std::move( exp ), size ), size );
+        }
+        /// @brief stops the stream after a elements, consumes this Enumerable
+        /// @param a amount of elements to take
+        auto take( size_t a ) && -> Enumerable<T>
+        {
+            auto size = batch_size;
+            return with_batch_size( take_impl( std::move( *this ), a ), size );
+        }
+        /// @brief drops the first a elements of the stream, consumes this Enumerable
+        /// @param a amount of elements to skip
+        auto skip( size_t a ) && -> Enumerable<T>
+        {
+            auto size = batch_size;
+            return with_batch_size( skip_impl( std::move( *this ), a ), size );
+        }
+
+        /// applies an expression on every element
+        template <class F> auto for_each( F exp ) -> void
+        {
+            while ( auto *batch = next_batch( ) )
+                for ( auto &e : *batch )
+                    exp( e );
+        }
+        /// applies an aggregate function on the stream
+        /// @param exp aggregate function to use. it takes the element and the value of the runs before. returns the
+        /// new value
+        /// @return result after the aggregate function was run on every element
+        template <class R, class F> auto aggregate( F exp ) -> R
+        {
+            R ret = R( );
+            for_each( [ & ]( T &e ) { ret = exp( e, std::move( ret ) ); } );
+            return ret;
+        }
+        /// @return amount of elements in the stream
+        auto count( ) -> size_t
+        {
+            size_t ret = 0;
+            while ( auto *batch = next_batch( ) )
+                ret += batch->size( );
+            return ret;
+        }
+        /// @return amount of elements complying with the expression
+        template <class P> auto count( P exp ) -> size_t
+        {
+            size_t ret = 0;
+            for_each( [ & ]( T &e ) { ret += exp( e ) ? 1 : 0; } );
+            return ret;
+        }
+        /// checks if any element complies with the expression, stops pulling at the first match
+        template <class P> auto any( P exp ) -> bool
+        {
+            while ( auto *batch = next_batch( ) )
+                for ( auto &e : *batch )
+                    if ( exp( e ) )
+                        return true;
+            return false;
+        }
+        /// checks if all elements comply with the expression, stops pulling at the first mismatch
+        template <class P> auto all( P exp ) -> bool
+        {
+            return !any( [ & ]( T &e ) { return !exp( e ); } );
+        }
+        /// Get the first element conforming to an expression. if no element conforms throw an exception
+        template <class P> auto first( P exp ) -> T
+        {
+            while ( auto *batch = next_batch( ) )
+                for ( auto &e : *batch )
+                    if ( exp( e ) )
+                        return std::move( e );
+            throw std::runtime_error( "No element matching predicate found" );
+        }
+        /// @brief groups the stream by a key
+        /// @param key key selector (callable or member pointer)
+        /// @return hash map from key to the List of elements with that key
+        template <class K> auto group_by( K key )
+        {
+            auto res = std::unordered_map<detail::key_t<K, T>, List<T>, detail::key_hash<detail::key_t<K, T>>>( );
+            for_each( [ & ]( T &e ) {
+                auto &group = res[ std::invoke( key, e ) ];
+                group.push_back( std::move( e ) );
+            } );
+            return res;
+        }
+        /// @brief folds the elements of every group in one pass, only the aggregated values are kept in memory
+        /// @param key key selector (callable or member pointer)
+        /// @param init start value of every group
+        /// @param exp aggregate function. it takes the element and the value of the group so far and returns the new
+        /// value
+        /// @return hash map from key to the aggregated value
+        template <class K, class A, class F> auto group_aggregate( K key, A init, F exp )
+        {
+            auto res = std::unordered_map<detail::key_t<K, T>, A, detail::key_hash<detail::key_t<K, T>>>( );
+            for_each( [ & ]( T &e ) {
+                auto it = res.try_emplace( std::invoke( key, e ), init ).first;
+                it->second = exp( e, std::move( it->second ) );
+            } );
+            return res;
+        }
+        /// @return all remaining elements of the stream
+        auto to_list( ) -> List<T>
+        {
+            auto ret = List<T>( );
+            while ( auto *batch = next_batch( ) )
+                ret.concat( std::move( *batch ) );
+            return ret;
+        }
+
+        /*! \cond */
+        static auto with_batch_size( Enumerable e, size_t size ) -> Enumerable
+        {
+            e.batch_size = size;
+            return e;
+        }
+        /*! \endcond */
+
+    private:
+        /*! \cond */
+        template <class P> static auto where_impl( Enumerable src, P exp, size_t size ) -> Enumerable
+        {
+            auto out = List<T>( );
+            while ( auto *batch = src.next_batch( ) )
+            {
+                for ( auto &e : *batch )
+                    if ( exp( e ) )
+                        out.push_back( std::move( e ) );
+                if ( out.size( ) >= size )
+                {
+                    co_yield std::move( out );
+                    out = List<T>( );
+                }
+            }
+            if ( !out.empty( ) )
+                co_yield std::move( out );
+        }
+
+        template <class R, class F> static auto select_impl( Enumerable src, F exp, size_t ) -> Enumerable<R>
+        {
+            auto out = List<R>( );
+            while ( auto *batch = src.next_batch( ) )
+            {
+                out.reserve( batch->size( ) );
+                for ( auto &e : *batch )
+                    out.push_back( exp( e ) );
+                co_yield std::move( out );
+                out = List<R>( );
+            }
+        }
+
+        static auto take_impl( Enumerable src, size_t a ) -> Enumerable
+        {
+            while ( a > 0 )
+            {
+                auto *batch = src.next_batch( );
+                if ( !batch )
+                    break;
+                batch->take_inplace( a );
+                a -= batch->size( );
+                co_yield std::move( *batch );
+            }
+        }
+
+        static auto skip_impl( Enumerable src, size_t a ) -> Enumerable
+        {
+            while ( auto *batch = src.next_batch( ) )
+            {
+                if ( a >= batch->size( ) )
+                {
+                    a -= batch->size( );
+                    continue;
+                }
+                batch->erase( batch->begin( ), batch->begin( ) + a );
+                a = 0;
+                co_yield std::move( *batch );
+            }
+        }
+        /*! \endcond */
+
+        std::coroutine_handle<promise_type> coroutine;
+        size_t batch_size;
+    };
+
+    /// @brief streams the elements of a List in batches
+    /// @param list elements to stream
+    /// @param batch_size amount of elements per batch
+    template <class T> auto from_list( List<T> list, size_t batch_size = default_batch_size ) -> Enumerable<T>
+    {
+        return Enumerable<T>::with_batch_size(
+            []( List<T> list, size_t batch_size ) -> Enumerable<T> {
+                for ( size_t i = 0; i < list.size( ); i += batch_size )
+                {
+                    auto end = list.begin( ) + static_cast<std::ptrdiff_t>( std::min( list.size( ), i + batch_size ) );
+                    co_yield List<T>( std::make_move_iterator( list.begin( ) + static_cast<std::ptrdiff_t>( i ) ),
+                                      std::make_move_iterator( end ) );
+                }
+            }( std::move( list ), batch_size ),
+            batch_size );
+    }
+
+    /// @brief reads a file in chunks, at most one chunk is held in memory. throws an exception if the file can not be
+    /// opened
+    /// @param path path of the file
+    /// @param chunk_size size of the chunks in bytes, the last chunk may be smaller
+    VROCKUTILS_API auto read_chunks( std::string path, size_t chunk_size = default_chunk_size )
+        -> Enumerable<std::shared_ptr<ByteArray>>;
+
+    /// @brief splits a stream of chunks into records separated by a delimiter. records can span multiple chunks, the
+    /// delimiter is not part of the record and a trailing record without delimiter is kept
+    /// @param chunks stream of binary data, for example from read_chunks
+    /// @param delimiter record delimiter
+    /// @param batch_size amount of records per batch
+    VROCKUTILS_API auto split( Enumerable<std::shared_ptr<ByteArray>> chunks, char delimiter = '\n',
+                               size_t batch_size = default_batch_size ) -> Enumerable<std::string>;
+
+    /*! \cond */
+    namespace detail
+    {
+        /// @brief resumes h on a background thread shared by all AsyncEnumerables
+        VROCKUTILS_API auto resume_on_executor( std::coroutine_handle<> h ) -> void;
+    } // namespace detail
+    /*! \endcond */
+
+    /// Stream whose batches are produced on a background thread and can be awaited with co_await.
+    ///
+    /// The producer thread pulls the source and keeps at most depth batches ready, so reading (I/O) overlaps with the
+    /// processing of the consumer. A coroutine waiting in co_await next_batch( ) is resumed by the scheduler, by
+    /// default on a separate executor thread shared by all AsyncEnumerables, never on the producer thread. A consumer
+    /// resumed there should not block, otherwise it delays the other consumers.
+    /// @tparam T type of the elements
+    template <class T> class AsyncEnumerable
+    {
+    public:
+        /// resumes a suspended consumer
+        using scheduler = std::function<void( std::coroutine_handle<> )>;
+
+        /// awaitable returned by next_batch, results in the next batch or std::nullopt at the end of the stream
+        class batch_awaiter
+        {
+        public:
+            explicit batch_awaiter( AsyncEnumerable *e ) : e( e )
+            {
+            }
+            auto await_ready( ) -> bool
+            {
+                auto lock = std::lock_guard( e->state->mutex );
+                return !e->state->queue.empty( ) || e->state->done;
+            }
+            auto await_suspend( std::coroutine_handle<> h ) -> bool
+            {
+                auto lock = std::lock_guard( e->state->mutex );
+                if ( !e->state->queue.empty( ) || e->state->done )
+                    return false;
+                e->state->waiter = h;
+                return true;
+            }
+            auto await_resume( ) -> std::optional<List<T>>
+            {
+                return e->state->pop( );
+            }
+
+        private:
+            AsyncEnumerable *e;
+        };
+
+        /// @param source stream to pull on the background thread
+        /// @param depth amount of batches that are produced ahead
+        /// @param resume scheduler that resumes waiting coroutines, uses the shared executor thread if empty
+        explicit AsyncEnumerable( Enumerable<T> source, size_t depth = 2, scheduler resume = nullptr )
+            : state( std::make_shared<shared>( std::move( source ), depth == 0 ? 1 : depth, std::move( resume ) ) )
+        {
+            producer = std::thread( [ s = state ] { s->produce( ); } );
+        }
+        AsyncEnumerable( const AsyncEnumerable & ) = delete;
+        auto operator=( const AsyncEnumerable & ) -> AsyncEnumerable & = delete;
+        ~AsyncEnumerable( )
+        {
+            {
+                auto lock = std::lock_guard( state->mutex );
+                state->stop = true;
+            }
+            state->space.notify_all( );
+            // a scheduler that resumes inline may destroy the stream on the producer thread, which cannot join itself.
+            // the producer owns a reference to the state and finishes on its own
+            if ( std::this_thread::get_id( ) == producer.get_id( ) )
+                producer.detach( );
+            else
+                producer.join( );
+        }
+
+    public:
+        /// @return awaitable resulting in the next batch or std::nullopt at the end of the stream
+        auto next_batch( ) -> batch_awaiter
+        {
+            return batch_awaiter( this );
+        }
+        /// @brief blocks until the next batch is available. rethrows exceptions of the source
+        /// @return the next batch or std::nullopt at the end of the stream
+        auto wait_batch( ) -> std::optional<List<T>>
+        {
+            {
+                auto lock = std::unique_lock( state->mutex );
+                state->ready.wait( lock, [ this ] { return !state->queue.empty( ) || state->done; } );
+            }
+            return state->pop( );
+        }
+
+    private:
+        /*! \cond */
+        /// state shared with the producer thread, which may outlive the AsyncEnumerable
+        struct shared
+        {
+            shared( Enumerable<T> source, size_t depth, scheduler resume )
+                : source( std::move( source ) ), depth( depth ), resume( std::move( resume ) )
+            {
+                if ( !this->resume )
+                    this->resume = detail::resume_on_executor;
+            }
+
+            auto produce( ) -> void
+            {
+                try
+                {
+                    while ( !stopped( ) )
+                    {
+                        auto *batch = source.next_batch( );
+                        if ( !batch )
+                            break;
+                        auto lock = std::unique_lock( mutex );
+                        space.wait( lock, [ this ] { return queue.size( ) < depth || stop; } );
+                        if ( stop )
+                            break;
+                        queue.push_back( std::move( *batch ) );
+                        wake( lock );
+                    }
+                }
+                catch ( ... )
+                {
+                    auto lock = std::lock_guard( mutex );
+                    error = std::current_exception( );
+                }
+                auto lock = std::unique_lock( mutex );
+                done = true;
+                wake( lock );
+            }
+
+            auto stopped( ) -> bool
+            {
+                auto lock = std::lock_guard( mutex );
+                return stop;
+            }
+
+            auto wake( std::unique_lock<std::mutex> &lock ) -> void
+            {
+                auto h = std::exchange( waiter, nullptr );
+                lock.unlock( );
+                ready.notify_all( );
+                if ( h )
+                    resume( h );
+            }
+
+            auto pop( ) -> std::optional<List<T>>
+            {
+                auto lock = std::unique_lock( mutex );
+                if ( queue.empty( ) )
+                {
+                    if ( auto e = std::exchange( error, nullptr ) )
+                        std::rethrow_exception( e );
+                    return std::nullopt;
+                }
+                auto batch = std::move( queue.front( ) );
+                queue.pop_front( );
+                lock.unlock( );
+                space.notify_all( );
+                return batch;
+            }
+
+            Enumerable<T> source;
+            size_t depth;
+            scheduler resume;
+
+            std::mutex mutex;
+            std::condition_variable ready;
+            std::condition_variable space;
+            std::deque<List<T>> queue;
+            std::coroutine_handle<> waiter = nullptr;
+            std::exception_ptr error;
+            bool done = false;
+            bool stop = false;
+        };
+        /*! \endcond */
+
+        std::shared_ptr<shared> state;
+        std::thread producer;
+    };
+
+    /// @brief pulls the source on a background thread, so reading the next batches overlaps with processing
+    /// @param source stream to prefetch
+    /// @param depth amount of batches that are produced ahead
+    template <class T> auto prefetch( Enumerable<T> source, size_t depth = 2 ) -> Enumerable<T>
+    {
+        auto size = source.get_batch_size( );
+        return Enumerable<T>::with_batch_size(
+            []( Enumerable<T> source, size_t depth ) -> Enumerable<T> {
+                auto async = AsyncEnumerable<T>( std::move( source ), depth );
+                while ( auto batch = async.wait_batch( ) )
+                    co_yield std::move( *batch );
+            }( std::move( source ), depth ),
+            size );
+    }
+} // namespace vrock::utils
@@ -0,0 +1,440 @@
+#pragma once
+
+#include "ByteArray.hpp"
+#include "Enumerable.hpp"
+#include "List.hpp"
+#include "Serialize.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vrock::utils
+{
+    /// settings of external_sort
+    struct ExternalSortOptions
+    {
+        /// bytes used for the elements of the in memory runs and the read buffers of the merge. elements are counted
+        /// with sizeof( T ), memory owned by the elements (e.g. string contents) is not included
+        size_t memory_budget = size_t( 256 ) << 20;
+        /// amount of threads sorting a run, each thread produces its own sorted run
+        size_t threads = 1;
+        /// directory of the temporary files, defaults to std::filesystem::temp_directory_path
+        std::string temp_directory;
+        /// size of the blocks written to the temporary files in bytes
+        size_t block_bytes = default_chunk_size;
+        /// amount of elements per batch of the result
+        size_t batch_size = default_batch_size;
+    };
+
+    /// codec of external_sort for trivially copyable elements, uses to_bytes and from_bytes. a Schema can be used as
+    /// codec for other types
+    /// @tparam T type of the elements
+    template <class T> struct RawCodec
+    {
+        auto to_bytes( const List<T> &list ) const -> std::shared_ptr<ByteArray>
+        {
+            return vrock::utils::to_bytes( list );
+        }
+        auto from_bytes( const ByteArray &bytes ) const -> List<T>
+        {
+            return vrock::utils::from_bytes<T>( bytes );
+        }
+    };
+
+    /*! \cond */
+    namespace detail
+    {
+        /// file in the temporary directory that is removed when the object is destroyed
+        class VROCKUTILS_API TempFile
+        {
+        public:
+            explicit TempFile( const std::string &directory );
+            TempFile( const TempFile & ) = delete;
+            TempFile( TempFile &&o ) noexcept;
+            auto operator=( const TempFile & ) -> TempFile & = delete;
+            auto operator=( TempFile &&o ) noexcept -> TempFile &;
+            ~TempFile( );
+
+            auto path( ) const -> const std::string &;
+
+        private:
+            std::string file;
+        };
+
+        /// writes length prefixed ByteArrays to a file
+        class VROCKUTILS_API BlockWriter
+        {
+        public:
+            explicit BlockWriter( const std::string &path );
+            auto write( const ByteArray &block ) -> void;
+            /// flushes the file, throws an exception if writing failed
+            auto close( ) -> void;
+
+        private:
+            std::ofstream out;
+            std::string path;
+        };
+
+        /// reads the blocks written by a BlockWriter
+        class VROCKUTILS_API BlockReader
+        {
+        public:
+            explicit BlockReader( const std::string &path );
+            /// @return the next block or nullptr at the end of the file
+            auto next( ) -> std::shared_ptr<ByteArray>;
+
+        private:
+            std::ifstream in;
+        };
+
+        template <class T> auto elements_per( size_t bytes ) -> size_t
+        {
+            return std::max<size_t>( 1, bytes / sizeof( T ) );
+        }
+
+        /// writes list in blocks of block_elements elements
+        template <class T, class Codec>
+        auto write_blocks( BlockWriter &writer, const T *data, size_t size, size_t block_elements, const Codec &codec )
+            -> void
+        {
+            for ( size_t i = 0; i < size; i += block_elements )
+            {
+                auto n = std::min( block_elements, size - i );
+                writer.write( *codec.to_bytes( List<T>( data + i, data + i + n ) ) );
+            }
+        }
+
+        /// sorts list in slices, one thread per slice, and returns the start of every slice
+        template <class T, class C> auto sort_slices( List<T> &list, C &cmp, size_t threads ) -> std::vector<size_t>
+        {
+            threads = std::max<size_t>( 1, std::min( threads, list.size( ) ) );
+            auto starts = std::vector<size_t>( );
+            for ( size_t t = 0; t <= threads; t++ )
+                starts.push_back( list.size( ) * t / threads );
+            auto sort = [ & ]( size_t t ) {
+                std::stable_sort( list.begin( ) + static_cast<std::ptrdiff_t>( starts[ t ] ),
+                                  list.begin( ) + static_cast<std::ptrdiff_t>( starts[ t + 1 ] ), cmp );
+            };
+            auto errors = std::vector<std::exception_ptr>( threads );
+            auto workers = std::vector<std::thread>( );
+            for ( size_t t = 1; t < threads; t++ )
+                workers.emplace_back( [ &, t ] {
+                    try
+                    {
+                        sort( t );
+                    }
+                    catch ( ... )
+                    {
+                        errors[ t ] = std::current_exception( );
+                    }
+                } );
+            try
+            {
+                sort( 0 );
+            }
+            catch ( ... )
+            {
+                errors[ 0 ] = std::current_exception( );
+            }
+            for ( auto &w : workers )
+                w.join( );
+            for ( auto &e : errors )
+                if ( e )
+                    std::rethrow_exception( e );
+            return starts;
+        }
+
+        /// sequential reader of a sorted run that reads read_ahead blocks at once
+        template <class T, class Codec> class run_reader
+        {
+        public:
+            run_reader( const std::string &path, size_t read_ahead, const Codec &codec )
+                : file( path ), read_ahead( read_ahead ), codec( &codec )
+            {
+                fill( );
+            }
+
+            auto done( ) const -> bool
+            {
+                return pos >= buffer.size( );
+            }
+            auto current( ) -> T &
+            {
+                return buffer[ pos ];
+            }
+            auto advance( ) -> void
+            {
+                if ( ++pos == buffer.size( ) )
+                    fill( );
+            }
+
+        private:
+            auto fill( ) -> void
+            {
+                buffer.clear( );
+                pos = 0;
+                for ( size_t i = 0; i < read_ahead; i++ )
+                {
+                    auto block = file.next( );
+                    if ( !block )
+                        break;
+                    buffer.concat( codec->from_bytes( *block ) );
+                }
+            }
+
+            BlockReader file;
+            size_t read_ahead;
+            const Codec *codec;
+            List<T> buffer;
+            size_t pos = 0;
+        };
+
+        /// tournament tree over k runs. the inner nodes store the loser of their match, node 0 the overall winner, so
+        /// replacing the winner needs log2( k ) comparisons along one path
+        template <class T, class Codec, class C> class loser_tree
+        {
+        public:
+            loser_tree( std::vector<run_reader<T, Codec>> &runs, C &cmp )
+                : runs( runs ), cmp( cmp ), tree( runs.size( ) )
+            {
+                auto k = runs.size( );
+                if ( k == 0 )
+                    return;
+                auto winners = std::vector<size_t>( 2 * k );
+                for ( size_t i = 0; i < k; i++ )
+                    winners[ k + i ] = i;
+                for ( size_t node = k - 1; node >= 1; node-- )
+                {
+                    auto a = winners[ 2 * node ], b = winners[ 2 * node + 1 ];
+                    winners[ node ] = beats( a, b ) ? a : b;
+                    tree[ node ] = beats( a, b ) ? b : a;
+                }
+                tree[ 0 ] = k == 1 ? 0 : winners[ 1 ];
+            }
+
+            /// @return index of the run with the smallest current element, or a run that is done if all are done
+            auto winner( ) const -> size_t
+            {
+                return tree[ 0 ];
+            }
+            /// @brief advances the winning run and replays its path
+            auto pop( ) -> void
+            {
+                auto k = runs.size( );
+                auto w = tree[ 0 ];
+                runs[ w ].advance( );
+                for ( auto node = ( w + k ) / 2; node >= 1; node /= 2 )
+                    if ( beats( tree[ node ], w ) )
+                        std::swap( tree[ node ], w );
+                tree[ 0 ] = w;
+            }
+
+        private:
+            /// a run that is done loses every match, ties are won by the earlier run to keep the sort stable
+            auto beats( size_t a, size_t b ) -> bool
+            {
+                if ( runs[ a ].done( ) )
+                    return false;
+                if ( runs[ b ].done( ) )
+                    return true;
+                if ( cmp( runs[ a ].current( ), runs[ b ].current( ) ) )
+                    return true;
+                if ( cmp( runs[ b ].current( ), runs[ a ].current( ) ) )
+                    return false;
+                return a < b;
+            }
+
+            std::vector<run_reader<T, Codec>> &runs;
+            C &cmp;
+            std::vector<size_t> tree;
+        };
+
+        /// merges runs into one new run in the order of the runs
+        template <class T, class C, class Codec>
+        auto merge_runs( const std::vector<TempFile> &files, size_t first, size_t last, C &cmp,
+                         const ExternalSortOptions &options, const Codec &codec ) -> TempFile
+        {
+            auto block_elements = elements_per<T>( options.block_bytes );
+            auto read_ahead = std::max<size_t>( 1, options.memory_budget / ( last - first + 1 ) / options.block_bytes );
+            auto runs = std::vector<run_reader<T, Codec>>( );
+            runs.reserve( last - first );
+            for ( auto i = first; i < last; i++ )
+                runs.emplace_back( files[ i ].path( ), read_ahead, codec );
+            auto tree = loser_tree<T, Codec, C>( runs, cmp );
+            auto out = TempFile( options.temp_directory );
+            auto writer = BlockWriter( out.path( ) );
+            auto block = List<T>( );
+            block.reserve( block_elements );
+            while ( !runs[ tree.winner( ) ].done( ) )
+            {
+                block.push_back( std::move( runs[ tree.winner( ) ].current( ) ) );
+                tree.pop( );
+                if ( block.size( ) == block_elements )
+                {
+                    writer.write( *codec.to_bytes( block ) );
+                    block.clear( );
+                }
+            }
+            if ( !block.empty( ) )
+                writer.write( *codec.to_bytes( block ) );
+            writer.close( );
+            return out;
+        }
+
+        template <class T, class C, class Codec>
+        auto external_sort_impl( Enumerable<T> input, C cmp, ExternalSortOptions options, Codec codec )
+            -> Enumerable<T>
+        {
+            auto run_elements = elements_per<T>( options.memory_budget );
+            auto block_elements = elements_per<T>( options.block_bytes );
+            auto files = std::vector<TempFile>( );
+            auto buffer = List<T>( );
+
+            // phase 1: sorted runs of at most memory_budget bytes, every thread sorts and writes its own run
+            auto spill = [ & ]( ) {
+                auto starts = sort_slices( buffer, cmp, options.threads );
+                for ( size_t s = 0; s + 1 < starts.size( ); s++ )
+                {
+                    files.emplace_back( options.temp_directory );
+                    auto writer = BlockWriter( files.back( ).path( ) );
+                    write_blocks( writer, buffer.data( ) + starts[ s ], starts[ s + 1 ] - starts[ s ], block_elements,
+                                  codec );
+                    writer.close( );
+                }
+                buffer.clear( );
+            };
+            while ( auto *batch = input.next_batch( ) )
+                for ( auto &e : *batch )
+                {
+                    buffer.push_back( std::move( e ) );
+                    if ( buffer.size( ) >= run_elements )
+                        spill( );
+                }
+
+            if ( files.empty( ) )
+            {
+                // everything fits into memory, merge the sorted slices in place
+                auto starts = sort_slices( buffer, cmp, options.threads );
+                auto at = [ & ]( size_t i ) { return buffer.begin( ) + static_cast<std::ptrdiff_t>( i ); };
+                for ( size_t s = 2; s < starts.size( ); s++ )
+                    std::inplace_merge( at( 0 ), at( starts[ s - 1 ] ), at( starts[ s ] ), cmp );
+                for ( size_t i = 0; i < buffer.size( ); i += options.batch_size )
+                {
+                    auto end = std::min( buffer.size( ), i + options.batch_size );
+                    co_yield List<T>( std::make_move_iterator( at( i ) ), std::make_move_iterator( at( end ) ) );
+                }
+                co_return;
+            }
+            if ( !buffer.empty( ) )
+                spill( );
+            buffer = List<T>( );
+
+            // phase 2: merge groups of consecutive runs until the read buffers of all runs fit into the budget
+            auto fan_in = std::max<size_t>( 2, options.memory_budget / options.block_bytes / 2 );
+            while ( files.size( ) > fan_in )
+            {
+                auto merged = std::vector<TempFile>( );
+                for ( size_t i = 0; i < files.size( ); i += fan_in )
+                    merged.push_back(
+                        merge_runs<T>( files, i, std::min( files.size( ), i + fan_in ), cmp, options, codec ) );
+                files = std::move( merged );
+            }
+
+            // phase 3: final k-way merge into the result stream
+            auto read_ahead =
+                std::max<size_t>( 1, options.memory_budget / ( files.size( ) + 1 ) / options.block_bytes );
+            auto runs = std::vector<run_reader<T, Codec>>( );
+            runs.reserve( files.size( ) );
+            for ( const auto &f : files )
+                runs.emplace_back( f.path( ), read_ahead, codec );
+            auto tree = loser_tree<T, Codec, C>( runs, cmp );
+            auto out = List<T>( );
+            while ( !runs[ tree.winner( ) ].done( ) )
+            {
+                out.push_back( std::move( runs[ tree.winner( ) ].current( ) ) );
+                tree.pop( );
+                if ( out.size( ) >= options.batch_size )
+                {
+                    co_yield std::move( out );
+                    out = List<T>( );
+                }
+            }
+            if ( !out.empty( ) )
+                co_yield std::move( out );
+        }
+
+        template <class T, class Codec> auto read_blocks_impl( BlockReader reader, Codec codec ) -> Enumerable<T>
+        {
+            while ( auto block = reader.next( ) )
+                co_yield codec.from_bytes( *block );
+        }
+    } // namespace detail
+    /*! \endcond */
+
+    /// @brief sorts a stream that may not fit into memory. runs of at most options.memory_budget bytes are sorted in
+    /// memory (by options.threads threads) and written to temporary files, which are merged with a loser tree. the
+    /// sort is stable. temporary files are removed when the result is destroyed
+    /// @param input stream to sort
+    /// @param cmp comparator, returns true if the first element is ordered before the second
+    /// @param options memory budget, threads and temporary directory
+    /// @param codec converts blocks of elements to ByteArrays and back, RawCodec or a Schema
+    /// @return stream of the sorted elements
+    template <class T, class C, class Codec = RawCodec<T>>
+    auto external_sort( Enumerable<T> input, C cmp, ExternalSortOptions options = { }, Codec codec = { } )
+        -> Enumerable<T>
+    {
+        if ( options.memory_budget == 0 || options.block_bytes == 0 )
+            throw std::invalid_argument( "memory budget and block size have to be greater than zero" );
+        options.batch_size = std::max<size_t>( 1, options.batch_size );
+        auto batch_size = options.batch_size;
+        auto sorted = detail::external_sort_impl( std::move( input ), std::move( cmp ), options, std::move( codec ) );
+        return Enumerable<T>::with_batch_size( std::move( sorted ), batch_size );
+    }
+
+    /// @brief sorts a stream ascending (see less) that may not fit into memory
+    /// @param input stream to sort
+    /// @param options memory budget, threads and temporary directory
+    /// @return stream of the sorted elements
+    template <class T> auto external_sort( Enumerable<T> input, ExternalSortOptions options = { } ) -> Enumerable<T>
+    {
+        return external_sort( std::move( input ), []( const T &a, const T &b ) { return less( a, b ); },
+                              std::move( options ) );
+    }
+
+    /// @brief sorts a stream that may not fit into memory and writes the result as blocks to a file, which can be read
+    /// with read_blocks
+    /// @param input stream to sort
+    /// @param path output file
+    /// @param cmp comparator, returns true if the first element is ordered before the second
+    /// @param options memory budget, threads and temporary directory
+    /// @param codec converts blocks of elements to ByteArrays and back
+    template <class T, class C, class Codec = RawCodec<T>>
+    auto external_sort_to_file( Enumerable<T> input, const std::string &path, C cmp, ExternalSortOptions options = { },
+                                Codec codec = { } ) -> void
+    {
+        options.batch_size = detail::elements_per<T>( options.block_bytes );
+        auto sorted = external_sort( std::move( input ), std::move( cmp ), options, codec );
+        auto writer = detail::BlockWriter( path );
+        while ( auto *batch = sorted.next_batch( ) )
+            writer.write( *codec.to_bytes( *batch ) );
+        writer.close( );
+    }
+
+    /// @brief streams the elements of a file written by external_sort_to_file, one block per batch
+    /// @param path file to read
+    /// @param codec codec the file was written with
+    template <class T, class Codec = RawCodec<T>>
+    auto read_blocks( const std::string &path, Codec codec = { } ) -> Enumerable<T>
+    {
+        return detail::read_blocks_impl<T>( detail::BlockReader( path ), std::move( codec ) );
+    }
+} // namespace vrock::utils
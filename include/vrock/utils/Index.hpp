@@ -0,0 +1,420 @@
+#pragma once
+
+#include "List.hpp"
+#include "ObservableList.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vrock::utils
+{
+    // List.hpp includes this header at its end, so ObservableList.hpp may still be in progress here
+    template <class T> class ListObserver;
+    template <class T> class ObservableList;
+
+    /*! \cond */
+    namespace detail
+    {
+        /// shared state of the indexes. an index over a List rebuilds itself lazily when the List changed size,
+        /// buffer or revision. writes that change none of these (operator[], iterators, std::vector mutators such
+        /// as pop_back followed by push_back) are not detected and need invalidate or rebuild. an index attached to
+        /// an ObservableList is updated on appends and removals at the end and rebuilt lazily after any other change.
+        template <class L> class index_base : public ListObserver<typename L::value_type>
+        {
+            using T = typename L::value_type;
+
+        public:
+            /// @brief marks the index as outdated, it is rebuilt on the next lookup. needed after the List was
+            /// modified without going through a List method (operator[], iterators, std::vector mutators)
+            auto invalidate( ) -> void
+            {
+                stale = true;
+            }
+
+        protected:
+            explicit index_base( const L &list ) : source( &list )
+            {
+            }
+
+            auto outdated( ) const -> bool
+            {
+                if ( stale )
+                    return true;
+                if ( this->observed( ) )
+                    return false;
+                return size != source->size( ) || data != source->data( ) || revision != source->revision( );
+            }
+
+            auto built( ) const -> void
+            {
+                stale = false;
+                size = source->size( );
+                data = source->data( );
+                revision = source->revision( );
+            }
+
+            /// true if the change at pos can be applied incrementally. pos is only valid at the end of the List
+            auto at_end( size_t pos, size_t size_with_element ) -> bool
+            {
+                if ( stale )
+                    return false;
+                if ( pos + 1 != size_with_element )
+                    stale = true;
+                return !stale;
+            }
+
+            const L *source;
+            mutable bool stale = true;
+            mutable size_t size = 0;
+            mutable const T *data = nullptr;
+            mutable size_t revision = 0;
+        };
+    } // namespace detail
+    /*! \endcond */
+
+    /// Hash index over a List for repeated lookups by key, created by List::index_by.
+    ///
+    /// Lookups cost O(1) instead of a linear scan. Elements with equal keys are returned in List order. The index is
+    /// rebuilt on the next lookup after the List was changed by one of its in place methods or changed its size.
+    ///
+    /// WARNING: writes that bypass the List methods are not detected and the index silently returns stale results.
+    /// This covers assignments through operator[] or iterators and std::vector mutators that keep the size (e.g.
+    /// pop_back followed by push_back). Call invalidate (lazy) or rebuild (eager) after such writes, or index an
+    /// ObservableList, whose indexes are kept up to date on every change.
+    /// @tparam L type of the indexed List
+    /// @tparam K key selector (callable or member pointer)
+    template <class L, class K> class HashIndex : public detail::index_base<L>
+    {
+        using T = typename L::value_type;
+
+    public:
+        using key_type = detail::key_t<K, T>;
+
+        /// @param list List to index, it must outlive the index
+        /// @param key key selector
+        /// @param unique if true, duplicate keys throw an exception
+        HashIndex( const L &list, K key, bool unique = false )
+            : detail::index_base<L>( list ), key( std::move( key ) ), unique( unique )
+        {
+            build( );
+        }
+        /// @param list ObservableList to index and follow, it must outlive the index
+        /// @param key key selector
+        /// @param unique if true, duplicate keys throw an exception
+        HashIndex( ObservableList<T> &list, K key, bool unique = false )
+            : detail::index_base<L>( list.list( ) ), key( std::move( key ) ), unique( unique )
+        {
+            list.subscribe( *this );
+            build( );
+        }
+
+    public:
+        /// @return true if an element with key k exists
+        auto contains( const key_type &k ) const -> bool
+        {
+            return find( k ) != nullptr;
+        }
+        /// @return amount of elements with key k
+        auto count( const key_type &k ) const -> size_t
+        {
+            auto *p = find( k );
+            return p ? p->size( ) : 0;
+        }
+        /// @return positions of the elements with key k in ascending order
+        auto positions( const key_type &k ) const -> std::vector<size_t>
+        {
+            auto *p = find( k );
+            return p ? *p : std::vector<size_t>( );
+        }
+        /// @return first element with key k. throws an exception if there is none
+        auto first( const key_type &k ) const -> T
+        {
+            auto *p = find( k );
+            if ( !p )
+                throw std::runtime_error( "No element matching predicate found" );
+            return ( *this->source )[ p->front( ) ];
+        }
+        /// @return first element with key k or _default if there is none
+        auto first_or_default( const key_type &k, T _default = T( ) ) const -> T
+        {
+            auto *p = find( k );
+            return p ? ( *this->source )[ p->front( ) ] : _default;
+        }
+        /// @return the only element with key k. throws an exception if there is none or more than one
+        auto single( const key_type &k ) const -> T
+        {
+            auto *p = find( k );
+            if ( !p )
+                throw std::runtime_error( "No element matching predicate found" );
+            if ( p->size( ) > 1 )
+                throw std::runtime_error( "more than one element matching the predicate found" );
+            return ( *this->source )[ p->front( ) ];
+        }
+        /// @return List with all elements with key k, using the allocator of the indexed List
+        auto where( const key_type &k ) const -> L
+        {
+            auto ret = L( this->source->get_allocator( ) );
+            if ( auto *p = find( k ) )
+            {
+                ret.reserve( p->size( ) );
+                for ( auto i : *p )
+                    ret.push_back( ( *this->source )[ i ] );
+            }
+            return ret;
+        }
+        /// @brief rebuilds the index immediately, needed after writes that bypass the List methods (see invalidate)
+        auto rebuild( ) -> void
+        {
+            build( );
+        }
+
+        auto on_insert( const T &e, size_t pos ) -> void override
+        {
+            if ( this->at_end( pos, this->source->size( ) ) )
+                add( e, pos );
+        }
+        auto on_erase( const T &e, size_t pos ) -> void override
+        {
+            if ( !this->at_end( pos, this->source->size( ) ) )
+                return;
+            auto it = index.find( std::invoke( key, e ) );
+            it->second.pop_back( );
+            if ( it->second.empty( ) )
+                index.erase( it );
+        }
+        auto on_clear( const List<T> & ) -> void override
+        {
+            index.clear( );
+            this->stale = false;
+        }
+
+    private:
+        /*! \cond */
+        auto find( const key_type &k ) const -> const std::vector<size_t> *
+        {
+            if ( this->outdated( ) )
+                build( );
+            auto it = index.find( k );
+            return it == index.end( ) ? nullptr : &it->second;
+        }
+
+        auto build( ) const -> void
+        {
+            index.clear( );
+            index.reserve( this->source->size( ) );
+            for ( size_t i = 0; i < this->source->size( ); i++ )
+                add( ( *this->source )[ i ], i );
+            this->built( );
+        }
+
+        auto add( const T &e, size_t pos ) const -> void
+        {
+            auto &positions = index[ std::invoke( key, e ) ];
+            if ( unique && !positions.empty( ) )
+            {
+                this->stale = true;
+                throw std::runtime_error( "duplicate key in unique index" );
+            }
+            positions.push_back( pos );
+        }
+        /*! \endcond */
+
+        K key;
+        bool unique;
+        mutable std::unordered_map<key_type, std::vector<size_t>, detail::key_hash<key_type>> index;
+    };
+
+    /// Sorted index over a List for repeated lookups and range queries by key, created by List::sorted_index_by.
+    ///
+    /// Lookups cost O(log n). Keys are ordered like less( ), elements with equal keys are returned in List order. The
+    /// index follows changes of the List like HashIndex.
+    ///
+    /// WARNING: like HashIndex, writes through operator[], iterators or std::vector mutators that keep the size are
+    /// not detected. Call invalidate or rebuild after such writes, or index an ObservableList.
+    /// @tparam L type of the indexed List
+    /// @tparam K key selector (callable or member pointer)
+    template <class L, class K> class SortedIndex : public detail::index_base<L>
+    {
+        using T = typename L::value_type;
+
+    public:
+        using key_type = detail::key_t<K, T>;
+
+        /// @param list List to index, it must outlive the index
+        /// @param key key selector
+        SortedIndex( const L &list, K key ) : detail::index_base<L>( list ), key( std::move( key ) )
+        {
+            build( );
+        }
+        /// @param list ObservableList to index and follow, it must outlive the index
+        /// @param key key selector
+        SortedIndex( ObservableList<T> &list, K key ) : detail::index_base<L>( list.list( ) ), key( std::move( key ) )
+        {
+            list.subscribe( *this );
+            build( );
+        }
+
+    public:
+        /// @return true if an element with key k exists
+        auto contains( const key_type &k ) const -> bool
+        {
+            auto [ lo, hi ] = equal( k );
+            return lo != hi;
+        }
+        /// @return amount of elements with key k
+        auto count( const key_type &k ) const -> size_t
+        {
+            auto [ lo, hi ] = equal( k );
+            return static_cast<size_t>( hi - lo );
+        }
+        /// @return first element with key k. throws an exception if there is none
+        auto first( const key_type &k ) const -> T
+        {
+            auto [ lo, hi ] = equal( k );
+            if ( lo == hi )
+                throw std::runtime_error( "No element matching predicate found" );
+            return ( *this->source )[ lo->second ];
+        }
+        /// @return first element with key k or _default if there is none
+        auto first_or_default( const key_type &k, T _default = T( ) ) const -> T
+        {
+            auto [ lo, hi ] = equal( k );
+            return lo == hi ? _default : ( *this->source )[ lo->second ];
+        }
+        /// @return the only element with key k. throws an exception if there is none or more than one
+        auto single( const key_type &k ) const -> T
+        {
+            auto [ lo, hi ] = equal( k );
+            if ( lo == hi )
+                throw std::runtime_error( "No element matching predicate found" );
+            if ( hi - lo > 1 )
+                throw std::runtime_error( "more than one element matching the predicate found" );
+            return ( *this->source )[ lo->second ];
+        }
+        /// @return List with all elements with key k
+        auto where( const key_type &k ) const -> L
+        {
+            auto [ lo, hi ] = equal( k );
+            return collect( lo, hi );
+        }
+        /// @return List with all elements whose key is in [lo, hi], ordered by key
+        auto range( const key_type &lo, const key_type &hi ) const -> L
+        {
+            if ( less( hi, lo ) )
+                return L( this->source->get_allocator( ) );
+            return collect( lower( lo ), upper( hi ) );
+        }
+        /// @return List with all elements whose key is less than k, ordered by key
+        auto where_less( const key_type &k ) const -> L
+        {
+            auto end = lower( k );
+            return collect( entries.cbegin( ), end );
+        }
+        /// @return List with all elements whose key is greater than k, ordered by key
+        auto where_greater( const key_type &k ) const -> L
+        {
+            auto begin = upper( k );
+            return collect( begin, entries.cend( ) );
+        }
+        /// @brief rebuilds the index immediately, needed after writes that bypass the List methods (see invalidate)
+        auto rebuild( ) -> void
+        {
+            build( );
+        }
+
+        auto on_insert( const T &e, size_t pos ) -> void override
+        {
+            if ( !this->at_end( pos, this->source->size( ) ) )
+                return;
+            auto k = key_type( std::invoke( key, e ) );
+            auto it = std::upper_bound( entries.begin( ), entries.end( ), k, key_less( ) );
+            entries.insert( it, { std::move( k ), pos } );
+        }
+        auto on_erase( const T &e, size_t pos ) -> void override
+        {
+            if ( !this->at_end( pos, this->source->size( ) ) )
+                return;
+            // the element at the end of the List has the largest position of its key
+            auto it = std::upper_bound( entries.begin( ), entries.end( ), key_type( std::invoke( key, e ) ),
+                                        key_less( ) );
+            entries.erase( it - 1 );
+        }
+        auto on_clear( const List<T> & ) -> void override
+        {
+            entries.clear( );
+            this->stale = false;
+        }
+
+    private:
+        /*! \cond */
+        using entry = std::pair<key_type, size_t>;
+        using iterator = typename std::vector<entry>::const_iterator;
+
+        struct key_less
+        {
+            auto operator( )( const entry &a, const key_type &b ) const -> bool
+            {
+                return less( a.first, b );
+            }
+            auto operator( )( const key_type &a, const entry &b ) const -> bool
+            {
+                return less( a, b.first );
+            }
+        };
+
+        auto lower( const key_type &k ) const -> iterator
+        {
+            if ( this->outdated( ) )
+                build( );
+            return std::lower_bound( entries.cbegin( ), entries.cend( ), k, key_less( ) );
+        }
+
+        auto upper( const key_type &k ) const -> iterator
+        {
+            if ( this->outdated( ) )
+                build( );
+            return std::upper_bound( entries.cbegin( ), entries.cend( ), k, key_less( ) );
+        }
+
+        auto equal( const key_type &k ) const -> std::pair<iterator, iterator>
+        {
+            if ( this->outdated( ) )
+                build( );
+            return std::equal_range( entries.cbegin( ), entries.cend( ), k, key_less( ) );
+        }
+
+        auto collect( iterator lo, iterator hi ) const -> L
+        {
+            auto ret = L( this->source->get_allocator( ) );
+            ret.reserve( static_cast<size_t>( hi - lo ) );
+            for ( ; lo != hi; ++lo )
+                ret.push_back( ( *this->source )[ lo->second ] );
+            return ret;
+        }
+
+        auto build( ) const -> void
+        {
+            entries.clear( );
+            entries.reserve( this->source->size( ) );
+            for ( size_t i = 0; i < this->source->size( ); i++ )
+                entries.emplace_back( std::invoke( key, ( *this->source )[ i ] ), i );
+            std::stable_sort( entries.begin( ), entries.end( ),
+                              []( const entry &a, const entry &b ) { return less( a.first, b.first ); } );
+            this->built( );
+        }
+        /*! \endcond */
+
+        K key;
+        mutable std::vector<entry> entries;
+    };
+
+    /*! \cond */
+    template <class T, class K> HashIndex( ObservableList<T> &, K, bool = false ) -> HashIndex<List<T>, K>;
+    template <class T, class K> SortedIndex( ObservableList<T> &, K ) -> SortedIndex<List<T>, K>;
+    /*! \endcond */
+} // namespace vrock::utils
@@ -7,10 +7,27 @@
 #include <vector>
 #include <algorithm>
 
+#include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
 #include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "NumericKernels.hpp"
+#include "Trace.hpp"
 
 namespace vrock::utils
 {
@@ -31,36 +48,309 @@ namespace vrock::utils
         }
         return a < b;
     }
+
+    namespace detail
+    {
+        inline auto hash_combine( size_t seed, size_t h ) -> size_t
+        {
+            return seed ^ ( h + 0x9e3779b97f4a7c15ULL + ( seed << 6 ) + ( seed >> 2 ) );
+        }
+
+        template <class K> struct key_hash
+        {
+            auto operator( )( const K &k ) const -> size_t
+            {
+                return std::hash<K>( )( k );
+            }
+        };
+
+        template <class A, class B> struct key_hash<std::pair<A, B>>
+        {
+            auto operator( )( const std::pair<A, B> &k ) const -> size_t
+            {
+                return hash_combine( key_hash<A>( )( k.first ), key_hash<B>( )( k.second ) );
+            }
+        };
+
+        template <class... K> struct key_hash<std::tuple<K...>>
+        {
+            auto operator( )( const std::tuple<K...> &k ) const -> size_t
+            {
+                return std::apply(
+                    []( const auto &...e ) {
+                        size_t seed = 0;
+                        ( ( seed = hash_combine( seed, key_hash<std::decay_t<decltype( e )>>( )( e ) ) ), ... );
+                        return seed;
+                    },
+                    k );
+            }
+        };
+
+        /// type of the key returned by the selector S for an element of type T
+        template <class S, class T> using key_t = std::decay_t<std::invoke_result_t<S &, const T &>>;
+
+        /// true if k is a floating point NaN. NaN keys never match in a join, as NaN does not compare equal to itself
+        template <class K> constexpr auto is_nan_key( const K &k ) -> bool
+        {
+            if constexpr ( std::is_floating_point_v<K> )
+                return std::isnan( k );
+            else
+                return false;
+        }
+
+        /// result type of List::sum, integers are summed with 64 bits and floating point values as double
+        template <class T>
+        using sum_t = std::conditional_t<
+            std::is_floating_point_v<T>, std::conditional_t<std::is_same_v<T, long double>, long double, double>,
+            std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+
+        /// running sum that supports removing values. floating point values use Neumaier's compensated summation,
+        /// so subtracting the values leaving a window does not accumulate rounding errors. NaN and infinities are
+        /// counted instead of added, so they only affect the sum while they are part of it
+        template <class S> struct running_sum
+        {
+            S sum{ };
+            S compensation{ };
+            size_t nan = 0;
+            size_t positive_inf = 0;
+            size_t negative_inf = 0;
+
+            auto add( S v ) -> void
+            {
+                if constexpr ( std::is_floating_point_v<S> )
+                {
+                    if ( !std::isfinite( v ) )
+                        return count( v, true );
+                    auto t = sum + v;
+                    if ( std::abs( sum ) >= std::abs( v ) )
+                        compensation += ( sum - t ) + v;
+                    else
+                        compensation += ( v - t ) + sum;
+                    sum = t;
+                }
+                else
+                    sum += v;
+            }
+            auto remove( S v ) -> void
+            {
+                if constexpr ( std::is_floating_point_v<S> )
+                {
+                    if ( !std::isfinite( v ) )
+                        return count( v, false );
+                    add( -v );
+                }
+                else
+                    sum -= v;
+            }
+            /// @return the sum, NaN if it contains NaN or both infinities and the infinity if it contains one
+            auto value( ) const -> S
+            {
+                if constexpr ( std::is_floating_point_v<S> )
+                {
+                    if ( nan > 0 || ( positive_inf > 0 && negative_inf > 0 ) )
+                        return std::numeric_limits<S>::quiet_NaN( );
+                    if ( positive_inf > 0 )
+                        return std::numeric_limits<S>::infinity( );
+                    if ( negative_inf > 0 )
+                        return -std::numeric_limits<S>::infinity( );
+                }
+                return sum + compensation;
+            }
+
+        private:
+            auto count( S v, bool entering ) -> void
+            {
+                auto &counter = std::isnan( v ) ? nan : v > 0 ? positive_inf : negative_inf;
+                entering ? counter++ : counter--;
+            }
+        };
+
+        /// start of the window of length size that contains t, windows are aligned to multiples of size
+        template <class K, class D> auto window_floor( const K &t, const D &size ) -> K
+        {
+            if constexpr ( std::is_floating_point_v<K> )
+                return static_cast<K>( std::floor( t / size ) * size );
+            else if constexpr ( std::is_arithmetic_v<K> )
+            {
+                auto r = static_cast<K>( t % size );
+                return r < 0 ? static_cast<K>( t - r - size ) : static_cast<K>( t - r );
+            }
+            else
+            {
+                // std::chrono::time_point
+                auto r = t.time_since_epoch( ) % size;
+                if ( r < D::zero( ) )
+                    r += size;
+                return std::chrono::time_point_cast<typename K::duration>( t - r );
+            }
+        }
+
+        /// key selector of an Ordering
+        template <class S, bool Descending> struct sort_key
+        {
+            S selector;
+        };
+
+        /// key types that are sorted with a LSD radix sort
+        template <class K>
+        constexpr bool radix_sortable = ( std::is_integral_v<K> || std::is_same_v<K, float> ||
+                                          std::is_same_v<K, double> ) && sizeof( K ) <= 8;
+
+        /// maps a key to an unsigned integer with the same order as less()
+        template <class K> auto radix_key( K v )
+        {
+            if constexpr ( std::is_floating_point_v<K> )
+            {
+                using U = std::conditional_t<sizeof( K ) == 4, uint32_t, uint64_t>;
+                constexpr U sign = U( 1 ) << ( sizeof( U ) * 8 - 1 );
+                if ( std::isnan( v ) )
+                    v = std::numeric_limits<K>::quiet_NaN( ); // positive NaN, sorts after +inf
+                if ( v == K( 0 ) )
+                    v = K( 0 ); // -0.0 and 0.0 are equal for less()
+                U bits;
+                std::memcpy( &bits, &v, sizeof( U ) );
+                return ( bits & sign ) ? U( ~bits ) : U( bits | sign );
+            }
+            else
+            {
+                using U = std::conditional_t<sizeof( K ) <= 4, uint32_t, uint64_t>;
+                using S = std::conditional_t<sizeof( K ) <= 4, int32_t, int64_t>;
+                if constexpr ( std::is_signed_v<K> )
+                    return U( static_cast<U>( static_cast<S>( v ) ) ^ ( U( 1 ) << ( sizeof( U ) * 8 - 1 ) ) );
+                else
+                    return static_cast<U>( v );
+            }
+        }
+
+        /// element types that have vectorized kernels
+        template <class T>
+        constexpr bool has_kernel = std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t> ||
+                                    std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+        /// chained hash table over the positions of a container, used as build side of hash joins.
+        /// positions with equal keys are chained in their original order.
+        template <class K> struct join_table
+        {
+            static constexpr size_t npos = static_cast<size_t>( -1 );
+
+            std::unordered_map<K, size_t, key_hash<K>> heads;
+            std::vector<size_t> next;
+
+            template <class C, class S> join_table( const C &c, S &key )
+            {
+                heads.reserve( c.size( ) );
+                next.assign( c.size( ), npos );
+                for ( size_t i = c.size( ); i-- > 0; )
+                {
+                    auto [ it, inserted ] = heads.try_emplace( K( std::invoke( key, c[ i ] ) ), i );
+                    if ( !inserted )
+                    {
+                        next[ i ] = it->second;
+                        it->second = i;
+                    }
+                }
+            }
+
+            auto first( const K &k ) const -> size_t
+            {
+                auto it = heads.find( k );
+                return it == heads.end( ) ? npos : it->second;
+            }
+        };
+    } // namespace detail
     /*! \endcond */
 
+    template <class T, class Alloc = std::allocator<T>> class List;
+    template <class L, class... Keys> class Ordering;
+    template <class L, class K> class HashIndex;
+    template <class L, class K> class SortedIndex;
+    template <class K> class HyperLogLog;
+    template <class V> class QuantileSketch;
+    template <class K> class SpaceSaving;
+    template <class K> struct Frequent;
+    template <class T> class WindowView;
+    template <class T, class Time> struct TimeWindow;
+
     /// List that adds Linq functionality
     ///
     /// this class adds Linq features like aggregate, select and group_by functions.
-    template <class T> class List : public std::vector<T>
+    template <class T, class Alloc> class List : public std::vector<T, Alloc>
     {
     public:
         /// Empty list
         List( )
         {
         }
+        /// @param alloc allocator for the elements and the results of the query operators
+        explicit List( const Alloc &alloc ) : std::vector<T, Alloc>( alloc )
+        {
+        }
         /// @param v List Elements
-        List( std::vector<T> v ) : std::vector<T>( v )
+        List( std::vector<T, Alloc> v ) : std::vector<T, Alloc>( std::move( v ) )
         {
         }
+        /// @param init List Elements
+        /// @param alloc allocator for the elements and the results of the query operators
+        List( std::initializer_list<T> init, const Alloc &alloc ) : std::vector<T, Alloc>( init, alloc )
+        {
+        }
+        /// @param first begin of the range to copy
+        /// @param last end of the range to copy
+        template <class It, std::enable_if_t<std::is_base_of_v<std::input_iterator_tag,
+                                                               typename std::iterator_traits<It>::iterator_category> &&
+                                                 std::is_convertible_v<typename std::iterator_traits<It>::reference, T>,
+                                             int> = 0>
+        List( It first, It last, const Alloc &alloc = Alloc( ) ) : std::vector<T, Alloc>( first, last, alloc )
+        {
+        }
+        /// @brief copies a List that uses a different allocator
+        /// @param o List to copy
+        /// @param alloc allocator for the elements and the results of the query operators
+        template <class A, std::enable_if_t<!std::is_same_v<A, Alloc>, int> = 0>
+        explicit List( const List<T, A> &o, const Alloc &alloc = Alloc( ) )
+            : std::vector<T, Alloc>( o.begin( ), o.end( ), alloc )
+        {
+        }
+
+        List( const List &o ) = default;
+        List( List &&o ) noexcept = default;
+        List( const List &o, const Alloc &alloc ) : std::vector<T, Alloc>( o, alloc )
+        {
+        }
+        auto operator=( const List &o ) -> List &
+        {
+            std::vector<T, Alloc>::operator=( o );
+            revisions++;
+            return *this;
+        }
+        /// moving between allocators that do not propagate and may differ (e.g. std::pmr) copies the elements and
+        /// may throw, like std::vector
+        auto operator=( List &&o ) noexcept(
+            std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+            std::allocator_traits<Alloc>::is_always_equal::value ) -> List &
+        {
+            std::vector<T, Alloc>::operator=( std::move( o ) );
+            revisions++;
+            return *this;
+        }
 
         ~List( )
         {
         }
 
     public:
+        /// List of R using this allocator rebound to R, the type of the results of select and join
+        template <class R>
+        using rebind = List<R, typename std::allocator_traits<Alloc>::template rebind_alloc<R>>;
+
         /// @return size of the list
-        auto inline count( ) -> size_t
+        auto inline count( ) const -> size_t
         {
             return this->size( );
         }
         /// applies an expression on the list
         /// @param exp an expression that is used for the for loop
-        auto inline for_each( std::function<void( T )> exp ) -> void
+        auto inline for_each( std::function<void( T )> exp ) const -> void
         {
             std::for_each( this->begin( ), this->end( ), exp );
         }
@@ -69,7 +359,7 @@ namespace vrock::utils
         /// @param exp aggregate function to use. it takes the element and the value of the runs befor. returns the new
         /// value
         /// @return result after the aggregate function was run on every element
-        template <class R> auto inline aggregate( std::function<R( T, R )> exp ) -> R
+        template <class R> auto inline aggregate( std::function<R( T, R )> exp ) const -> R
         {
             R ret = R( );
             for_each( [ & ]( T i ) { ret = exp( i, ret ); } );
@@ -78,91 +368,136 @@ namespace vrock::utils
         /// sets the given list with the value of the current list
         /// @param l list to copy to
         /// @return the current list
-        auto inline let( List<T> *l ) -> List<T>
+        auto inline let( List *l ) const -> const List &
         {
-            l->resize( this->size( ) );
-            std::copy( this->begin( ), this->end( ), l->begin( ) );
+            l->assign( this->begin( ), this->end( ) );
+            l->revisions++;
             return *this;
         }
         /// checks if a given value is contained in the List
         /// @param val value to check
         /// @return value in this List
-        auto inline contains( T val ) -> bool
+        auto inline contains( const T &val ) const -> bool
         {
-            return any( [ val ]( T it ) { return it == val; } );
+            return std::find( this->begin( ), this->end( ), val ) != this->end( );
         }
         /// checks if the List contains any element
-        auto inline any( ) -> bool
+        auto inline any( ) const -> bool
         {
             return !this->empty( );
         }
         /// checks if the List contains any specific element
         /// @param exp expression to check for the wanted element
-        auto inline any( std::function<bool( T )> exp ) -> bool
+        auto inline any( std::function<bool( T )> exp ) const -> bool
         {
             return std::find_if( this->begin( ), this->end( ), exp ) != this->end( );
         }
         /// checks if all elements in the List conform to an expression
         /// @param exp expresion to check against
-        auto inline all( std::function<bool( T )> exp ) -> bool
+        auto inline all( std::function<bool( T )> exp ) const -> bool
         {
             if ( std::find_if_not( this->begin( ), this->end( ), exp ) == this->end( ) )
                 return true;
             return false;
         }
         /// check if the given List and the current List are equal
-        auto inline sequence_equal( List<T> o ) -> bool
+        auto inline sequence_equal( const List &o ) const -> bool
         {
             return *this == o;
         }
         /// concatenates two lists together and returns the result
-        auto inline concat( List<T> o ) -> List<T>
+        auto inline concat( const List &o ) & -> List &
         {
             this->insert( this->end( ), o.begin( ), o.end( ) );
+            revisions++;
             return *this;
         }
+        /// concatenates two lists together and returns the result, the elements of o are moved
+        auto inline concat( List &&o ) & -> List &
+        {
+            if ( this->empty( ) && this->get_allocator( ) == o.get_allocator( ) )
+                this->swap( o );
+            else
+                this->insert( this->end( ), std::make_move_iterator( o.begin( ) ),
+                              std::make_move_iterator( o.end( ) ) );
+            revisions++;
+            return *this;
+        }
+        /// concatenates two lists together and returns the result, reusing the buffer of this temporary List
+        auto inline concat( const List &o ) && -> List
+        {
+            return std::move( concat( o ) );
+        }
+        /// concatenates two lists together and returns the result, reusing the buffer of this temporary List
+        auto inline concat( List &&o ) && -> List
+        {
+            return std::move( concat( std::move( o ) ) );
+        }
         /// skips elements in the list and return the remaining
         /// @param a amount to skip
-        auto inline skip( size_t a ) -> List<T>
+        auto inline skip( size_t a ) const & -> List
         {
             if ( a > this->size( ) )
-                return List<T>( );
-            return List<T>( std::vector<T>( this->begin( ) + a, this->end( ) ) );
+                return List( this->get_allocator( ) );
+            return List( this->begin( ) + a, this->end( ), this->get_allocator( ) );
+        }
+        /// skips elements in the list and return the remaining, reusing the buffer of this temporary List
+        /// @param a amount to skip
+        auto inline skip( size_t a ) && -> List
+        {
+            this->erase( this->begin( ), this->begin( ) + std::min( a, this->size( ) ) );
+            return std::move( *this );
         }
         /// skip elements till the expression evaluates to false
-        auto inline skip_while( std::function<bool( T )> exp ) -> List<T>
+        auto inline skip_while( std::function<bool( T )> exp ) const -> List
         {
             auto it = std::find_if_not( this->begin( ), this->end( ), exp );
-            if ( it == this->end( ) )
-                return List<T>( );
-            return List<T>( std::vector<T>( it, this->end( ) ) );
+            return List( it, this->end( ), this->get_allocator( ) );
         }
         /// @param a amount of elements to take
         /// @return List with the first a elements from this List
-        auto inline take( size_t a ) -> List<T>
+        auto inline take( size_t a ) const & -> List
         {
-            if ( a > this->size( ) )
-                return List<T>( std::vector<T>( this->begin( ), this->end( ) ) );
-            return List<T>( std::vector<T>( this->begin( ), this->begin( ) + a ) );
+            return List( this->begin( ), this->begin( ) + std::min( a, this->size( ) ), this->get_allocator( ) );
+        }
+        /// @param a amount of elements to take
+        /// @return List with the first a elements from this List, reusing the buffer of this temporary List
+        auto inline take( size_t a ) && -> List
+        {
+            return std::move( take_inplace( a ) );
+        }
+        /// removes all but the first a elements
+        /// @param a amount of elements to keep
+        /// @return this List
+        auto inline take_inplace( size_t a ) -> List &
+        {
+            if ( a < this->size( ) )
+                this->erase( this->begin( ) + a, this->end( ) );
+            revisions++;
+            return *this;
         }
         /// takes elements till the expression evaluates to false
-        auto inline take_while( std::function<bool( T )> exp ) -> List<T>
+        auto inline take_while( std::function<bool( T )> exp ) const -> List
         {
             auto it = std::find_if_not( this->begin( ), this->end( ), exp );
-            if ( it == this->end( ) )
-                return List<T>( std::vector<T>( this->begin( ), this->end( ) ) );
-            return List<T>( std::vector<T>( this->begin( ), it ) );
+            return List( this->begin( ), it, this->get_allocator( ) );
         }
         /// revers the order of elements
-        auto inline revers( ) -> List<T>
+        auto inline revers( ) & -> List &
         {
             std::reverse( this->begin( ), this->end( ) );
+            revisions++;
             return *this;
         }
+        /// revers the order of elements, reusing the buffer of this temporary List
+        auto inline revers( ) && -> List
+        {
+            return std::move( revers( ) );
+        }
         /// Get the first element conforming to an expression. if no element conforms throw an exception
         /// @param exp expression to check against
         /// @return first element that complies with the expression
-        auto inline first( std::function<bool( T )> exp ) -> T
+        auto inline first( std::function<bool( T )> exp ) const -> T
         {
             auto res = std::find_if( this->begin( ), this->end( ), exp );
             if ( res == this->end( ) )
@@ -172,7 +507,7 @@ namespace vrock::utils
         /// Get the first element conforming to an expression. if no element conforms return a default value
         /// @param exp expression to check against
         /// @return first element that complies with the expression
-        auto inline first_or_default( std::function<bool( T )> exp, T _default = T( ) ) -> T
+        auto inline first_or_default( std::function<bool( T )> exp, T _default = T( ) ) const -> T
         {
             auto res = std::find_if( this->begin( ), this->end( ), exp );
             if ( res == this->end( ) )
@@ -182,7 +517,7 @@ namespace vrock::utils
         /// Get the last element conforming to an expression. if no element conforms throw an exception
         /// @param exp expression to check against
         /// @return last element that complies with the expression
-        auto inline last( std::function<bool( T )> exp ) -> T
+        auto inline last( std::function<bool( T )> exp ) const -> T
         {
             auto res = std::find_if( this->rbegin( ), this->rend( ), exp );
             if ( res == this->rend( ) )
@@ -192,7 +527,7 @@ namespace vrock::utils
         /// Get the last element conforming to an expression. if no element conforms return a default value
         /// @param exp expression to check against
         /// @return last element that complies with the expression
-        auto inline last_or_default( std::function<bool( T )> exp, T _default = T( ) ) -> T
+        auto inline last_or_default( std::function<bool( T )> exp, T _default = T( ) ) const -> T
         {
             auto res = std::find_if( this->rbegin( ), this->rend( ), exp );
             if ( res == this->rend( ) )
@@ -202,7 +537,7 @@ namespace vrock::utils
         /// get a single element conforming to an expression. if multiple conform it throws an exception
         /// @param exp expression to check against
         /// @return the element conforming to exp
-        auto inline single( std::function<bool( T )> exp ) -> T
+        auto inline single( std::function<bool( T )> exp ) const -> T
         {
             auto res1 = std::find_if( this->begin( ), this->end( ), exp );
             if ( res1 == this->end( ) )
@@ -216,7 +551,7 @@ namespace vrock::utils
         /// element was found return the default
         /// @param exp expression to check against
         /// @return the element conforming to exp
-        auto inline single_or_default( std::function<bool( T )> exp, T _default = T( ) ) -> T
+        auto inline single_or_default( std::function<bool( T )> exp, T _default = T( ) ) const -> T
         {
             auto res1 = std::find_if( this->begin( ), this->end( ), exp );
             if ( res1 == this->end( ) )
@@ -230,157 +565,1003 @@ namespace vrock::utils
         /// @tparam R type of the newly created list
         /// @param exp expression which takes an element of type T and return an element of type R
         /// @return List with all elements
-        template <class R> auto inline select( std::function<R( T )> exp ) -> List<R>
+        template <class R> auto inline select( std::function<R( T )> exp ) const -> rebind<R>
         {
-            List<R> ret = List<R>( );
-            std::for_each( this->begin( ), this->end( ), [ & ]( T i ) { ret.push_back( exp( i ) ); } );
+            VROCKUTILS_TRACE_OP( "List::select", this->size( ) );
+            auto ret = rebind<R>( this->get_allocator( ) );
+            ret.reserve( this->size( ) );
+            std::for_each( this->begin( ), this->end( ), [ & ]( const T &i ) { ret.push_back( exp( i ) ); } );
+            VROCKUTILS_TRACE_RESULT( ret );
             return ret;
         }
         /// @brief apply a filter (exp) to the list
         /// @param exp expression to decide if an element should be in the resulting list
         /// @return list with all elements complying to the expression
-        auto inline where( std::function<bool( T )> exp ) -> List<T>
+        auto inline where( std::function<bool( T )> exp ) const & -> List
         {
-            auto ret = List<T>( );
-            std::for_each( this->begin( ), this->end( ), [ & ]( T i ) {
+            VROCKUTILS_TRACE_OP( "List::where", this->size( ) );
+            auto ret = List( this->get_allocator( ) );
+            std::for_each( this->begin( ), this->end( ), [ & ]( const T &i ) {
                 if ( exp( i ) )
                     ret.push_back( i );
             } );
+            VROCKUTILS_TRACE_RESULT( ret );
             return ret;
         }
-        /// @brief Joins the current list on o
+        /// @brief apply a filter (exp) to the list, reusing the buffer of this temporary List
+        /// @param exp expression to decide if an element should be in the resulting list
+        /// @return list with all elements complying to the expression
+        auto inline where( std::function<bool( T )> exp ) && -> List
+        {
+            return std::move( where_inplace( exp ) );
+        }
+        /// @brief removes all elements not complying to the expression, keeping the order of the remaining ones
+        /// @param exp expression to decide if an element should stay in the list
+        /// @return this List
+        auto inline where_inplace( std::function<bool( T )> exp ) -> List &
+        {
+            VROCKUTILS_TRACE_OP( "List::where_inplace", this->size( ) );
+            this->erase( std::remove_if( this->begin( ), this->end( ), [ & ]( const T &i ) { return !exp( i ); } ),
+                         this->end( ) );
+            revisions++;
+            VROCKUTILS_TRACE_RESULT( *this );
+            return *this;
+        }
+        /// @brief Joins the current list on o using a nested loop. Use this form for non-equi joins, equi joins should
+        /// use the key selector overload
         /// @tparam R type of the List o
         /// @tparam E type of the resulting List
         /// @param o List to join on
         /// @param exp1 expression to that returns if two elements should be joined
         /// @param exp2 expression that returns a new joined element
         /// @return resulting joined List
-        template <class R, class E>
-        auto inline join( List<R> o, std::function<bool( T, R )> exp1, std::function<E( T, R )> exp2 ) -> List<E>
+        template <class R, class E, class RA>
+        auto inline join( const List<R, RA> &o, std::function<bool( T, R )> exp1,
+                          std::function<E( T, R )> exp2 ) const -> rebind<E>
         {
-            auto ret = List<E>( );
+            VROCKUTILS_TRACE_OP( "List::join(predicate)", this->size( ) + o.size( ) );
+            auto ret = rebind<E>( this->get_allocator( ) );
             std::for_each( this->begin( ), this->end( ), [ & ]( auto i ) {
                 std::for_each( o.begin( ), o.end( ), [ & ]( auto j ) {
                     if ( exp1( i, j ) )
                         ret.push_back( exp2( i, j ) );
                 } );
             } );
+            VROCKUTILS_TRACE_RESULT( ret );
+            return ret;
+        }
+        /// @brief hash equi join of the current list with o. the hash table is build on the smaller list. if the
+        /// current list is the larger one the result is ordered like the current list, otherwise like o. keys are
+        /// compared with ==, so NaN keys never match
+        /// @param o List to join on
+        /// @param left_key key selector (callable or member pointer) for the elements of this List
+        /// @param right_key key selector (callable or member pointer) for the elements of o
+        /// @param exp expression that takes (const T &, const R &) and returns a new joined element
+        /// @return resulting joined List
+        template <class R, class KL, class KR, class F, class RA>
+        auto inline join( const List<R, RA> &o, KL left_key, KR right_key, F exp ) const
+            -> rebind<std::decay_t<std::invoke_result_t<F &, const T &, const R &>>>
+        {
+            using K = std::common_type_t<detail::key_t<KL, T>, detail::key_t<KR, R>>;
+            VROCKUTILS_TRACE_OP( "List::join", this->size( ) + o.size( ) );
+            auto ret = rebind<std::decay_t<std::invoke_result_t<F &, const T &, const R &>>>( this->get_allocator( ) );
+            if ( this->size( ) <= o.size( ) )
+            {
+                auto table = detail::join_table<K>( *this, left_key );
+                for ( const auto &r : o )
+                {
+                    auto key = K( std::invoke( right_key, r ) );
+                    for ( auto i = table.first( key ); i != table.npos; i = table.next[ i ] )
+                        ret.push_back( exp( ( *this )[ i ], r ) );
+                }
+            }
+            else
+            {
+                auto table = detail::join_table<K>( o, right_key );
+                for ( const auto &l : *this )
+                {
+                    auto key = K( std::invoke( left_key, l ) );
+                    for ( auto i = table.first( key ); i != table.npos; i = table.next[ i ] )
+                        ret.push_back( exp( l, o[ i ] ) );
+                }
+            }
+            VROCKUTILS_TRACE_RESULT( ret );
+            return ret;
+        }
+        /// @brief sort merge equi join. both lists have to be sorted ascending by their keys. the result is ordered by
+        /// the key. like join, NaN keys never match
+        /// @param o List to join on
+        /// @param left_key key selector (callable or member pointer) for the elements of this List
+        /// @param right_key key selector (callable or member pointer) for the elements of o
+        /// @param exp expression that takes (const T &, const R &) and returns a new joined element
+        /// @return resulting joined List
+        template <class R, class KL, class KR, class F, class RA>
+        auto inline merge_join( const List<R, RA> &o, KL left_key, KR right_key, F exp ) const
+            -> rebind<std::decay_t<std::invoke_result_t<F &, const T &, const R &>>>
+        {
+            using K = std::common_type_t<detail::key_t<KL, T>, detail::key_t<KR, R>>;
+            VROCKUTILS_TRACE_OP( "List::merge_join", this->size( ) + o.size( ) );
+            auto ret = rebind<std::decay_t<std::invoke_result_t<F &, const T &, const R &>>>( this->get_allocator( ) );
+            size_t i = 0, j = 0;
+            while ( i < this->size( ) && j < o.size( ) )
+            {
+                const K lk = std::invoke( left_key, ( *this )[ i ] );
+                const K rk = std::invoke( right_key, o[ j ] );
+                if ( less( lk, rk ) )
+                    ++i;
+                else if ( less( rk, lk ) )
+                    ++j;
+                else
+                {
+                    // find the run of equal keys on both sides and emit the cross product
+                    size_t i_end = i + 1, j_end = j + 1;
+                    while ( i_end < this->size( ) && !less( lk, K( std::invoke( left_key, ( *this )[ i_end ] ) ) ) )
+                        ++i_end;
+                    while ( j_end < o.size( ) && !less( rk, K( std::invoke( right_key, o[ j_end ] ) ) ) )
+                        ++j_end;
+                    if ( !detail::is_nan_key( lk ) )
+                        for ( auto a = i; a < i_end; ++a )
+                            for ( auto b = j; b < j_end; ++b )
+                                ret.push_back( exp( ( *this )[ a ], o[ b ] ) );
+                    i = i_end;
+                    j = j_end;
+                }
+            }
+            VROCKUTILS_TRACE_RESULT( ret );
+            return ret;
+        }
+        /// @brief hash left join. every element of this List is kept, elements without a partner are passed with a
+        /// nullptr. the result is ordered like this List
+        /// @param o List to join on
+        /// @param left_key key selector (callable or member pointer) for the elements of this List
+        /// @param right_key key selector (callable or member pointer) for the elements of o
+        /// @param exp expression that takes (const T &, const R *) and returns a new joined element
+        /// @return resulting joined List
+        template <class R, class KL, class KR, class F, class RA>
+        auto inline left_join( const List<R, RA> &o, KL left_key, KR right_key, F exp ) const
+            -> rebind<std::decay_t<std::invoke_result_t<F &, const T &, const R *>>>
+        {
+            using K = std::common_type_t<detail::key_t<KL, T>, detail::key_t<KR, R>>;
+            VROCKUTILS_TRACE_OP( "List::left_join", this->size( ) + o.size( ) );
+            auto ret = rebind<std::decay_t<std::invoke_result_t<F &, const T &, const R *>>>( this->get_allocator( ) );
+            auto table = detail::join_table<K>( o, right_key );
+            for ( const auto &l : *this )
+            {
+                auto i = table.first( K( std::invoke( left_key, l ) ) );
+                if ( i == table.npos )
+                    ret.push_back( exp( l, static_cast<const R *>( nullptr ) ) );
+                for ( ; i != table.npos; i = table.next[ i ] )
+                    ret.push_back( exp( l, &o[ i ] ) );
+            }
+            VROCKUTILS_TRACE_RESULT( ret );
+            return ret;
+        }
+        /// @brief hash full outer join. elements of either List without a partner are passed with a nullptr for the
+        /// other side. the matches and unmatched elements of this List come first, unmatched elements of o last
+        /// @param o List to join on
+        /// @param left_key key selector (callable or member pointer) for the elements of this List
+        /// @param right_key key selector (callable or member pointer) for the elements of o
+        /// @param exp expression that takes (const T *, const R *) and returns a new joined element
+        /// @return resulting joined List
+        template <class R, class KL, class KR, class F, class RA>
+        auto inline outer_join( const List<R, RA> &o, KL left_key, KR right_key, F exp ) const
+            -> rebind<std::decay_t<std::invoke_result_t<F &, const T *, const R *>>>
+        {
+            using K = std::common_type_t<detail::key_t<KL, T>, detail::key_t<KR, R>>;
+            VROCKUTILS_TRACE_OP( "List::outer_join", this->size( ) + o.size( ) );
+            auto ret = rebind<std::decay_t<std::invoke_result_t<F &, const T *, const R *>>>( this->get_allocator( ) );
+            auto table = detail::join_table<K>( o, right_key );
+            auto matched = std::vector<bool>( o.size( ), false );
+            for ( const auto &l : *this )
+            {
+                auto i = table.first( K( std::invoke( left_key, l ) ) );
+                if ( i == table.npos )
+                    ret.push_back( exp( &l, static_cast<const R *>( nullptr ) ) );
+                for ( ; i != table.npos; i = table.next[ i ] )
+                {
+                    matched[ i ] = true;
+                    ret.push_back( exp( &l, &o[ i ] ) );
+                }
+            }
+            for ( size_t i = 0; i < o.size( ); ++i )
+                if ( !matched[ i ] )
+                    ret.push_back( exp( static_cast<const T *>( nullptr ), &o[ i ] ) );
+            VROCKUTILS_TRACE_RESULT( ret );
+            return ret;
+        }
+        /// @brief hash semi join. keeps the elements of this List that have at least one partner in o
+        /// @param o List to join on
+        /// @param left_key key selector (callable or member pointer) for the elements of this List
+        /// @param right_key key selector (callable or member pointer) for the elements of o
+        /// @return filtered List
+        template <class R, class KL, class KR, class RA>
+        auto inline semi_join( const List<R, RA> &o, KL left_key, KR right_key ) const -> List
+        {
+            VROCKUTILS_TRACE_OP( "List::semi_join", this->size( ) + o.size( ) );
+            auto ret = filter_by_keys( o, left_key, right_key, true );
+            VROCKUTILS_TRACE_RESULT( ret );
+            return ret;
+        }
+        /// @brief hash anti join. keeps the elements of this List that have no partner in o
+        /// @param o List to join on
+        /// @param left_key key selector (callable or member pointer) for the elements of this List
+        /// @param right_key key selector (callable or member pointer) for the elements of o
+        /// @return filtered List
+        template <class R, class KL, class KR, class RA>
+        auto inline anti_join( const List<R, RA> &o, KL left_key, KR right_key ) const -> List
+        {
+            VROCKUTILS_TRACE_OP( "List::anti_join", this->size( ) + o.size( ) );
+            auto ret = filter_by_keys( o, left_key, right_key, false );
+            VROCKUTILS_TRACE_RESULT( ret );
+            return ret;
+        }
+        /// @brief hash group join. every element of this List is combined with the List of all its partners in o
+        /// @param o List to join on
+        /// @param left_key key selector (callable or member pointer) for the elements of this List
+        /// @param right_key key selector (callable or member pointer) for the elements of o
+        /// @param exp expression that takes (const T &, const List<R> &) and returns a new joined element
+        /// @return resulting joined List, ordered like this List
+        template <class R, class KL, class KR, class F, class RA>
+        auto inline group_join( const List<R, RA> &o, KL left_key, KR right_key, F exp ) const
+            -> rebind<std::decay_t<std::invoke_result_t<F &, const T &, const List<R, RA> &>>>
+        {
+            using K = std::common_type_t<detail::key_t<KL, T>, detail::key_t<KR, R>>;
+            VROCKUTILS_TRACE_OP( "List::group_join", this->size( ) + o.size( ) );
+            using E = std::decay_t<std::invoke_result_t<F &, const T &, const List<R, RA> &>>;
+            auto ret = rebind<E>( this->get_allocator( ) );
+            ret.reserve( this->size( ) );
+            auto table = detail::join_table<K>( o, right_key );
+            auto group = List<R, RA>( o.get_allocator( ) );
+            for ( const auto &l : *this )
+            {
+                group.clear( );
+                auto key = K( std::invoke( left_key, l ) );
+                for ( auto i = table.first( key ); i != table.npos; i = table.next[ i ] )
+                    group.push_back( o[ i ] );
+                ret.push_back( exp( l, group ) );
+            }
+            VROCKUTILS_TRACE_RESULT( ret );
             return ret;
         }
 
-        /// @brief groups the list by the given parameters
+        /// @brief groups the list by the given parameters, the groups are ordered by their key
         /// @tparam ...R types of the parameters to group by
-        /// @param ...params the parameter to group by
+        /// @param ...params the parameter to group by. either member pointers or key selectors taking a const T &
         /// @return resulting grouped map
-        template <typename... R> auto inline group_by( R... params )
+        template <typename... R> auto inline group_by( R... params ) const
         {
-            using key_type = std::tuple<typename remove_pointers<R>::type...>;
+            using key_type = std::tuple<detail::key_t<R, T>...>;
+            VROCKUTILS_TRACE_OP( "List::group_by", this->size( ) );
 
             auto comp = make_tuple_less<R...>( );
-            auto counter = std::map<key_type, std::vector<int>, decltype( comp )>( comp );
-
-            for ( size_t i = 0; i < this->size( ); i++ )
-            {
-                const auto key = std::make_tuple( ( this->at( i ).*params )... );
-                counter[ key ].emplace_back( i );
-            }
-
-            auto res = std::map<key_type, List<T>, decltype( comp )>( comp );
+            auto res = std::map<key_type, List, decltype( comp )>( comp );
+            for ( const auto &e : *this )
+                res.try_emplace( key_type( std::invoke( params, e )... ), this->get_allocator( ) )
+                    .first->second.push_back( e );
+            VROCKUTILS_TRACE_RESULT( res );
+            return res;
+        }
+        /// @brief groups the list by the given parameters into a hash map. faster than group_by if the order of the
+        /// groups is not needed
+        /// @tparam ...R types of the parameters to group by
+        /// @param ...params the parameter to group by. either member pointers or key selectors taking a const T &
+        /// @return resulting grouped hash map
+        template <typename... R> auto inline unordered_group_by( R... params ) const
+        {
+            using key_type = std::tuple<detail::key_t<R, T>...>;
+            VROCKUTILS_TRACE_OP( "List::unordered_group_by", this->size( ) );
 
-            for ( auto &[ key, i ] : counter )
+            auto res = std::unordered_map<key_type, List, detail::key_hash<key_type>>( );
+            for ( const auto &e : *this )
+                res.try_emplace( key_type( std::invoke( params, e )... ), this->get_allocator( ) )
+                    .first->second.push_back( e );
+            VROCKUTILS_TRACE_RESULT( res );
+            return res;
+        }
+        /// @brief folds the elements of every group in one pass without building the groups
+        /// @param key key selector (callable or member pointer)
+        /// @param init start value of every group
+        /// @param exp aggregate function. it takes the element and the value of the group so far and returns the new
+        /// value
+        /// @return hash map from key to the aggregated value
+        template <class K, class A, class F> auto inline group_aggregate( K key, A init, F exp ) const
+        {
+            VROCKUTILS_TRACE_OP( "List::group_aggregate", this->size( ) );
+            auto res = std::unordered_map<detail::key_t<K, T>, A, detail::key_hash<detail::key_t<K, T>>>( );
+            for ( const auto &e : *this )
             {
-                auto &g = res[ key ];
-                g = List<T>( std::vector<T>( i.size( ) ) );
-                std::transform( i.begin( ), i.end( ), g.begin( ), [ & ]( auto index ) { return this->at( index ); } );
+                auto it = res.try_emplace( std::invoke( key, e ), init ).first;
+                it->second = exp( e, std::move( it->second ) );
             }
+            VROCKUTILS_TRACE_RESULT( res );
             return res;
         }
+        /// @param key key selector (callable or member pointer)
+        /// @return hash map from key to the number of elements with that key
+        template <class K> auto inline group_count( K key ) const
+        {
+            return group_aggregate( key, size_t( 0 ), []( const T &, size_t c ) { return c + 1; } );
+        }
+        /// @param key key selector (callable or member pointer)
+        /// @param value value selector (callable or member pointer)
+        /// @return hash map from key to the sum of the values with that key, summed in the same type as sum
+        template <class K, class V> auto inline group_sum( K key, V value ) const
+        {
+            using S = detail::sum_t<detail::key_t<V, T>>;
+            return group_aggregate( key, S( ),
+                                    [ &value ]( const T &e, S s ) { return s + S( std::invoke( value, e ) ); } );
+        }
+        /// @param key key selector (callable or member pointer)
+        /// @param value value selector (callable or member pointer)
+        /// @return hash map from key to the smallest value with that key
+        template <class K, class V> auto inline group_min( K key, V value ) const
+        {
+            return group_extreme( key, value, []( const auto &a, const auto &b ) { return less( a, b ); } );
+        }
+        /// @param key key selector (callable or member pointer)
+        /// @param value value selector (callable or member pointer)
+        /// @return hash map from key to the largest value with that key
+        template <class K, class V> auto inline group_max( K key, V value ) const
+        {
+            return group_extreme( key, value, []( const auto &a, const auto &b ) { return less( b, a ); } );
+        }
         /// @brief orders the List by a given predicate
         /// @param exp expression to order by
         /// @return ordered List
-        auto inline order_by( std::function<bool( T, T )> exp ) -> List<T>
+        auto inline order_by( std::function<bool( T, T )> exp ) & -> List &
         {
+            VROCKUTILS_TRACE_OP( "List::order_by", this->size( ) );
             std::sort( this->begin( ), this->end( ), exp );
+            revisions++;
+            VROCKUTILS_TRACE_RESULT( *this );
             return *this;
         }
+        /// @brief orders the List by a given predicate, reusing the buffer of this temporary List
+        /// @param exp expression to order by
+        /// @return ordered List
+        auto inline order_by( std::function<bool( T, T )> exp ) && -> List
+        {
+            return std::move( order_by( exp ) );
+        }
+        /// @brief orders the List ascending by a key. the key is extracted once per element and the List itself is not
+        /// modified. the ordering is executed by to_list or take
+        /// @param key key selector (callable or member pointer)
+        /// @return Ordering over this List, it must not outlive the List
+        template <class K, std::enable_if_t<std::is_invocable_v<K &, const T &>, int> = 0>
+        auto inline order_by( K key ) const & -> Ordering<List, detail::sort_key<K, false>>
+        {
+            return Ordering<List, detail::sort_key<K, false>>( this,
+                                                            std::make_tuple( detail::sort_key<K, false>{ key } ) );
+        }
+        /// @brief orders this temporary List ascending by a key. the List is moved into the Ordering
+        /// @param key key selector (callable or member pointer)
+        /// @return Ordering owning the List
+        template <class K, std::enable_if_t<std::is_invocable_v<K &, const T &>, int> = 0>
+        auto inline order_by( K key ) && -> Ordering<List, detail::sort_key<K, false>>
+        {
+            return Ordering<List, detail::sort_key<K, false>>( std::make_shared<const List>( std::move( *this ) ),
+                                                            std::make_tuple( detail::sort_key<K, false>{ key } ) );
+        }
+        /// @brief orders the List descending by a key. the key is extracted once per element and the List itself is
+        /// not modified. the ordering is executed by to_list or take
+        /// @param key key selector (callable or member pointer)
+        /// @return Ordering over this List, it must not outlive the List
+        template <class K>
+        auto inline order_by_descending( K key ) const & -> Ordering<List, detail::sort_key<K, true>>
+        {
+            return Ordering<List, detail::sort_key<K, true>>( this,
+                                                              std::make_tuple( detail::sort_key<K, true>{ key } ) );
+        }
+        /// @brief orders this temporary List descending by a key. the List is moved into the Ordering
+        /// @param key key selector (callable or member pointer)
+        /// @return Ordering owning the List
+        template <class K> auto inline order_by_descending( K key ) && -> Ordering<List, detail::sort_key<K, true>>
+        {
+            return Ordering<List, detail::sort_key<K, true>>( std::make_shared<const List>( std::move( *this ) ),
+                                                              std::make_tuple( detail::sort_key<K, true>{ key } ) );
+        }
         /// @return List containing distinct elements
-        auto inline distinct( ) -> List<T>
+        auto inline distinct( ) const & -> List
         {
-            auto ret = List<T>( );
-            std::for_each( this->begin( ), this->end( ), [ & ]( T i ) {
+            VROCKUTILS_TRACE_OP( "List::distinct", this->size( ) );
+            auto ret = List( this->get_allocator( ) );
+            std::for_each( this->begin( ), this->end( ), [ & ]( const T &i ) {
                 if ( !ret.contains( i ) )
                     ret.push_back( i );
             } );
+            VROCKUTILS_TRACE_RESULT( ret );
             return ret;
         }
+        /// @return List containing distinct elements, reusing the buffer of this temporary List
+        auto inline distinct( ) && -> List
+        {
+            return std::move( distinct_inplace( ) );
+        }
+        /// @brief removes all elements that already occurred earlier in the List
+        /// @return this List
+        auto inline distinct_inplace( ) -> List &
+        {
+            VROCKUTILS_TRACE_OP( "List::distinct_inplace", this->size( ) );
+            auto end = this->begin( );
+            for ( auto it = this->begin( ); it != this->end( ); ++it )
+                if ( std::find( this->begin( ), end, *it ) == end )
+                {
+                    if ( end != it )
+                        *end = std::move( *it );
+                    ++end;
+                }
+            this->erase( end, this->end( ) );
+            revisions++;
+            VROCKUTILS_TRACE_RESULT( *this );
+            return *this;
+        }
         /// @brief applies a union on the current and the given list
         /// @param other List to perform the union on
         /// @return resulting union list
-        auto inline union_list( List<T> other ) -> List<T>
+        auto inline union_list( const List &other ) const -> List
         {
-            return this->concat( other ).distinct( );
+            auto ret = List( this->get_allocator( ) );
+            ret.reserve( this->size( ) + other.size( ) );
+            ret.insert( ret.end( ), this->begin( ), this->end( ) );
+            ret.insert( ret.end( ), other.begin( ), other.end( ) );
+            return std::move( ret.distinct_inplace( ) );
         }
         /// @brief returns all elements contained in both Lists
         /// @param other List to intersect with
         /// @return resulting intersection
-        auto inline intersect( List<T> other ) -> List<T>
+        auto inline intersect( const List &other ) const -> List
         {
-            auto ret = List<T>( );
-            this->for_each( [ & ]( T i ) {
+            VROCKUTILS_TRACE_OP( "List::intersect", this->size( ) + other.size( ) );
+            auto ret = List( this->get_allocator( ) );
+            std::for_each( this->begin( ), this->end( ), [ & ]( const T &i ) {
                 if ( other.contains( i ) )
                     ret.push_back( i );
             } );
+            VROCKUTILS_TRACE_RESULT( ret );
             return ret;
         }
         /// @brief returns a List filled with all entries that are not in the given list
         /// @param other list of elements to exclude
         /// @return filtered list
-        auto inline except( List<T> other ) -> List<T>
+        auto inline except( const List &other ) const -> List
         {
-            auto ret = List<T>( );
-            this->for_each( [ & ]( T i ) {
+            VROCKUTILS_TRACE_OP( "List::except", this->size( ) + other.size( ) );
+            auto ret = List( this->get_allocator( ) );
+            std::for_each( this->begin( ), this->end( ), [ & ]( const T &i ) {
                 if ( !other.contains( i ) )
                     ret.push_back( i );
             } );
+            VROCKUTILS_TRACE_RESULT( ret );
+            return ret;
+        }
+
+        /// @param exp expression to check against
+        /// @return amount of elements complying with the expression
+        template <class P> auto inline count( P exp ) const -> size_t
+        {
+            return static_cast<size_t>( std::count_if( this->begin( ), this->end( ), exp ) );
+        }
+        /// @return sum of all elements. integers are summed with 64 bits, floating point values as double
+        template <class U = T, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+        auto inline sum( ) const -> detail::sum_t<U>
+        {
+            if constexpr ( detail::has_kernel<U> )
+                return kernels::sum( this->data( ), this->size( ) );
+            else
+            {
+                auto ret = detail::sum_t<U>( );
+                for ( auto v : *this )
+                    ret += v;
+                return ret;
+            }
+        }
+        /// @return mean of all elements. throws an exception if the List is empty
+        template <class U = T, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+        auto inline average( ) const -> std::conditional_t<std::is_same_v<U, long double>, long double, double>
+        {
+            using R = std::conditional_t<std::is_same_v<U, long double>, long double, double>;
+            if ( this->empty( ) )
+                throw std::runtime_error( "List is empty" );
+            return static_cast<R>( sum( ) ) / static_cast<R>( this->size( ) );
+        }
+        /// @return smallest element. NaN is only returned if every element is NaN. throws an exception if the List is
+        /// empty
+        template <class U = T, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0> auto inline min( ) const -> T
+        {
+            if ( this->empty( ) )
+                throw std::runtime_error( "List is empty" );
+            if constexpr ( detail::has_kernel<U> )
+                return kernels::min( this->data( ), this->size( ) );
+            else
+                return *std::min_element( this->begin( ), this->end( ), []( T a, T b ) { return less( a, b ); } );
+        }
+        /// @return largest element. NaN is returned if any element is NaN. throws an exception if the List is empty
+        template <class U = T, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0> auto inline max( ) const -> T
+        {
+            if ( this->empty( ) )
+                throw std::runtime_error( "List is empty" );
+            if constexpr ( detail::has_kernel<U> )
+                return kernels::max( this->data( ), this->size( ) );
+            else
+            {
+                T ret = this->front( );
+                for ( auto v : *this )
+                    if ( less( ret, v ) )
+                        ret = v;
+                return ret;
+            }
+        }
+        /// @param key key selector (callable or member pointer), evaluated once per element
+        /// @return first element with the smallest key. throws an exception if the List is empty
+        template <class K> auto inline min_by( K key ) const -> T
+        {
+            return extreme_by( key, []( const auto &a, const auto &b ) { return less( a, b ); } );
+        }
+        /// @param key key selector (callable or member pointer), evaluated once per element
+        /// @return first element with the largest key. throws an exception if the List is empty
+        template <class K> auto inline max_by( K key ) const -> T
+        {
+            return extreme_by( key, []( const auto &a, const auto &b ) { return less( b, a ); } );
+        }
+        /// @param v value to compare against
+        /// @return List with all elements smaller than v
+        template <class U = T, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+        auto inline where_less( T v ) const -> List
+        {
+            return compare_filter( kernels::Compare::less, v, v );
+        }
+        /// @param v value to compare against
+        /// @return List with all elements greater than v
+        template <class U = T, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+        auto inline where_greater( T v ) const -> List
+        {
+            return compare_filter( kernels::Compare::greater, v, v );
+        }
+        /// @param v value to compare against
+        /// @return List with all elements equal to v
+        template <class U = T, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+        auto inline where_equal( T v ) const -> List
+        {
+            return compare_filter( kernels::Compare::equal, v, v );
+        }
+        /// @param lo lower bound, inclusive
+        /// @param hi upper bound, inclusive
+        /// @return List with all elements in [lo, hi]
+        template <class U = T, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+        auto inline where_between( T lo, T hi ) const -> List
+        {
+            return compare_filter( kernels::Compare::between, lo, hi );
+        }
+
+        /// @brief builds a hash index for repeated lookups by key
+        /// @param key key selector (callable or member pointer)
+        /// @param unique if true, duplicate keys throw an exception
+        /// @return HashIndex over this List, it must not outlive the List. writes through operator[], iterators or
+        /// std::vector mutators are not detected, call invalidate on the index after them
+        template <class K> auto inline index_by( K key, bool unique = false ) const -> HashIndex<List, K>
+        {
+            return HashIndex<List, K>( *this, std::move( key ), unique );
+        }
+        /// @brief builds a sorted index for repeated lookups and range queries by key
+        /// @param key key selector (callable or member pointer)
+        /// @return SortedIndex over this List, it must not outlive the List. writes through operator[], iterators
+        /// or std::vector mutators are not detected, call invalidate on the index after them
+        template <class K> auto inline sorted_index_by( K key ) const -> SortedIndex<List, K>
+        {
+            return SortedIndex<List, K>( *this, std::move( key ) );
+        }
+        /// @brief estimates the number of distinct elements with a HyperLogLog sketch, in one pass and 2^precision
+        /// bytes. the relative standard error is 1.04 / sqrt( 2^precision ), about 0.8% for the default
+        /// @param precision log2 of the number of registers, between 4 and 18
+        /// @return estimated number of distinct elements
+        auto inline approx_count_distinct( uint8_t precision = 14 ) const -> double
+        {
+            return approx_count_distinct( []( const T &e ) -> const T & { return e; }, precision );
+        }
+        /// @brief estimates the number of distinct keys with a HyperLogLog sketch
+        /// @param key key selector (callable or member pointer)
+        /// @param precision log2 of the number of registers, between 4 and 18
+        /// @return estimated number of distinct keys
+        template <class K, std::enable_if_t<std::is_invocable_v<K &, const T &>, int> = 0>
+        auto inline approx_count_distinct( K key, uint8_t precision = 14 ) const -> double
+        {
+            VROCKUTILS_TRACE_OP( "List::approx_count_distinct", this->size( ) );
+            auto sketch = HyperLogLog<detail::key_t<K, T>>( precision );
+            for ( const auto &e : *this )
+                sketch.add( std::invoke( key, e ) );
+            return sketch.estimate( );
+        }
+        /// @brief approximates a quantile with a KLL sketch instead of sorting. the rank of the result differs from q
+        /// by about 1.3% for the default k, see QuantileSketch
+        /// @param q rank between 0 and 1, 0.5 is the median
+        /// @param k accuracy parameter of the sketch
+        /// @return value whose rank is approximately q. throws an exception if the List is empty
+        template <class U = T, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+        auto inline approx_quantile( double q, size_t k = 200 ) const -> T
+        {
+            return quantile_sketch( []( T e ) { return e; }, k ).quantile( q );
+        }
+        /// @brief builds a KLL sketch of the values, to query multiple quantiles or merge it with other sketches
+        /// @param value value selector (callable or member pointer)
+        /// @param k accuracy parameter of the sketch
+        /// @return QuantileSketch of the values
+        template <class K>
+        auto inline quantile_sketch( K value, size_t k = 200 ) const -> QuantileSketch<detail::key_t<K, T>>
+        {
+            VROCKUTILS_TRACE_OP( "List::quantile_sketch", this->size( ) );
+            auto sketch = QuantileSketch<detail::key_t<K, T>>( k );
+            for ( const auto &e : *this )
+                sketch.add( std::invoke( value, e ) );
+            return sketch;
+        }
+        /// @brief finds the most frequent elements with the Space-Saving algorithm in O( capacity ) memory
+        /// @param n amount of elements to return
+        /// @param capacity amount of counters, counts are at most size( ) / capacity too high
+        /// @return up to n elements with their estimated count, most frequent first
+        auto inline top_frequent( size_t n, size_t capacity = 1024 ) const -> List<Frequent<T>>
+        {
+            return top_frequent( n, []( const T &e ) -> const T & { return e; }, capacity );
+        }
+        /// @brief finds the most frequent keys with the Space-Saving algorithm in O( capacity ) memory
+        /// @param n amount of keys to return
+        /// @param key key selector (callable or member pointer)
+        /// @param capacity amount of counters, counts are at most size( ) / capacity too high
+        /// @return up to n keys with their estimated count, most frequent first
+        template <class K, std::enable_if_t<std::is_invocable_v<K &, const T &>, int> = 0>
+        auto inline top_frequent( size_t n, K key, size_t capacity = 1024 ) const
+            -> List<Frequent<detail::key_t<K, T>>>
+        {
+            VROCKUTILS_TRACE_OP( "List::top_frequent", this->size( ) );
+            auto sketch = SpaceSaving<detail::key_t<K, T>>( std::max( n, capacity ) );
+            for ( const auto &e : *this )
+                sketch.add( std::invoke( key, e ) );
+            auto ret = sketch.top( n );
+            VROCKUTILS_TRACE_RESULT( ret );
+            return ret;
+        }
+
+        /// @brief splits the List into consecutive chunks without copying, the last chunk may be shorter
+        /// @param n amount of elements per chunk
+        /// @return WindowView over this List, it must not outlive the List
+        auto inline chunk( size_t n ) const -> WindowView<T>
+        {
+            return WindowView<T>( std::span<const T>( this->data( ), this->size( ) ), n, n, true );
+        }
+        /// @brief sliding windows of w elements without copying, only complete windows are included
+        /// @param w amount of elements per window
+        /// @param step distance between the starts of two windows
+        /// @return WindowView over this List, it must not outlive the List
+        auto inline window( size_t w, size_t step = 1 ) const -> WindowView<T>
+        {
+            return WindowView<T>( std::span<const T>( this->data( ), this->size( ) ), w, w == 0 ? 0 : step, false );
+        }
+        /// @param w amount of elements per window
+        /// @param step distance between the starts of two windows
+        /// @return sum of every complete window, O( 1 ) per element. a window containing NaN, or both infinities,
+        /// sums to NaN and one containing an infinity to that infinity; the other windows are not affected
+        template <class U = T, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+        auto inline sliding_sum( size_t w, size_t step = 1 ) const -> rebind<detail::sum_t<U>>
+        {
+            return sliding_sum( []( T e ) { return e; }, w, step );
+        }
+        /// @param value value selector (callable or member pointer)
+        /// @param w amount of elements per window
+        /// @param step distance between the starts of two windows
+        /// @return sum of the values of every complete window, O( 1 ) per element. NaN and infinities only affect
+        /// the windows containing them, like in sliding_sum( w, step )
+        template <class V, std::enable_if_t<std::is_invocable_v<V &, const T &>, int> = 0>
+        auto inline sliding_sum( V value, size_t w, size_t step = 1 ) const
+            -> rebind<detail::sum_t<detail::key_t<V, T>>>
+        {
+            VROCKUTILS_TRACE_OP( "List::sliding_sum", this->size( ) );
+            auto ret = rebind<detail::sum_t<detail::key_t<V, T>>>( this->get_allocator( ) );
+            sliding_sums( value, w, step, [ & ]( auto sum ) { ret.push_back( sum ); } );
+            VROCKUTILS_TRACE_RESULT( ret );
+            return ret;
+        }
+        /// @param w amount of elements per window
+        /// @param step distance between the starts of two windows
+        /// @return mean of every complete window, O( 1 ) per element. a window containing NaN, or both infinities,
+        /// has a NaN mean and one containing an infinity that infinity; the other windows are not affected
+        template <class U = T, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+        auto inline sliding_mean( size_t w, size_t step = 1 ) const
+            -> rebind<std::conditional_t<std::is_same_v<U, long double>, long double, double>>
+        {
+            return sliding_mean( []( T e ) { return e; }, w, step );
+        }
+        /// @param value value selector (callable or member pointer)
+        /// @param w amount of elements per window
+        /// @param step distance between the starts of two windows
+        /// @return mean of the values of every complete window, O( 1 ) per element. NaN and infinities only affect
+        /// the windows containing them, like in sliding_mean( w, step )
+        template <class V, std::enable_if_t<std::is_invocable_v<V &, const T &>, int> = 0>
+        auto inline sliding_mean( V value, size_t w, size_t step = 1 ) const -> rebind<
+            std::conditional_t<std::is_same_v<detail::key_t<V, T>, long double>, long double, double>>
+        {
+            using R = std::conditional_t<std::is_same_v<detail::key_t<V, T>, long double>, long double, double>;
+            VROCKUTILS_TRACE_OP( "List::sliding_mean", this->size( ) );
+            auto ret = rebind<R>( this->get_allocator( ) );
+            sliding_sums( value, w, step,
+                          [ & ]( auto sum ) { ret.push_back( static_cast<R>( sum ) / static_cast<R>( w ) ); } );
+            VROCKUTILS_TRACE_RESULT( ret );
+            return ret;
+        }
+        /// @param w amount of elements per window
+        /// @param step distance between the starts of two windows
+        /// @return smallest element of every complete window, amortized O( 1 ) per element. NaN is only returned if
+        /// every element of the window is NaN
+        template <class U = T, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+        auto inline sliding_min( size_t w, size_t step = 1 ) const -> List
+        {
+            return sliding_min( []( T e ) { return e; }, w, step );
+        }
+        /// @param value value selector (callable or member pointer)
+        /// @param w amount of elements per window
+        /// @param step distance between the starts of two windows
+        /// @return smallest value of every complete window, amortized O( 1 ) per element
+        template <class V, std::enable_if_t<std::is_invocable_v<V &, const T &>, int> = 0>
+        auto inline sliding_min( V value, size_t w, size_t step = 1 ) const -> rebind<detail::key_t<V, T>>
+        {
+            VROCKUTILS_TRACE_OP( "List::sliding_min", this->size( ) );
+            auto ret = sliding_extreme( value, w, step, []( const auto &a, const auto &b ) { return less( a, b ); } );
+            VROCKUTILS_TRACE_RESULT( ret );
+            return ret;
+        }
+        /// @param w amount of elements per window
+        /// @param step distance between the starts of two windows
+        /// @return largest element of every complete window, amortized O( 1 ) per element. NaN is returned if any
+        /// element of the window is NaN
+        template <class U = T, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+        auto inline sliding_max( size_t w, size_t step = 1 ) const -> List
+        {
+            return sliding_max( []( T e ) { return e; }, w, step );
+        }
+        /// @param value value selector (callable or member pointer)
+        /// @param w amount of elements per window
+        /// @param step distance between the starts of two windows
+        /// @return largest value of every complete window, amortized O( 1 ) per element
+        template <class V, std::enable_if_t<std::is_invocable_v<V &, const T &>, int> = 0>
+        auto inline sliding_max( V value, size_t w, size_t step = 1 ) const -> rebind<detail::key_t<V, T>>
+        {
+            VROCKUTILS_TRACE_OP( "List::sliding_max", this->size( ) );
+            auto ret = sliding_extreme( value, w, step, []( const auto &a, const auto &b ) { return less( b, a ); } );
+            VROCKUTILS_TRACE_RESULT( ret );
+            return ret;
+        }
+        /// @brief non overlapping time windows [k * size, ( k + 1 ) * size). the List has to be ordered ascending by
+        /// the time key, windows without elements are skipped
+        /// @param time time key selector (callable or member pointer), returning a number or a std::chrono::time_point
+        /// @param size length of the windows, a number or a std::chrono::duration
+        /// @return windows in ascending order, the elements are views into this List
+        template <class K, class D>
+        auto inline tumbling_window( K time, D size ) const -> List<TimeWindow<T, detail::key_t<K, T>>>
+        {
+            return sliding_window( time, size, size );
+        }
+        /// @brief overlapping time windows [k * slide, k * slide + size). the List has to be ordered ascending by the
+        /// time key, windows without elements are skipped
+        /// @param time time key selector (callable or member pointer), returning a number or a std::chrono::time_point
+        /// @param size length of the windows, a number or a std::chrono::duration
+        /// @param slide distance between the starts of two windows
+        /// @return windows in ascending order, the elements are views into this List
+        template <class K, class D>
+        auto inline sliding_window( K time, D size, D slide ) const -> List<TimeWindow<T, detail::key_t<K, T>>>
+        {
+            using Time = detail::key_t<K, T>;
+            if ( !( D( ) < size ) || !( D( ) < slide ) )
+                throw std::invalid_argument( "window size and slide have to be greater than zero" );
+            VROCKUTILS_TRACE_OP( "List::sliding_window", this->size( ) );
+            auto ret = List<TimeWindow<T, Time>>( );
+            auto at = [ & ]( size_t i ) -> Time { return std::invoke( time, ( *this )[ i ] ); };
+            for ( size_t i = 1; i < this->size( ); i++ )
+                if ( at( i ) < at( i - 1 ) )
+                    throw std::invalid_argument( "List is not ordered by the time key" );
+
+            auto shift = []( const Time &t, const D &d, bool back = false ) -> Time {
+                if constexpr ( std::is_arithmetic_v<Time> )
+                    return static_cast<Time>( back ? t - d : t + d );
+                else
+                    return std::chrono::time_point_cast<typename Time::duration>( back ? t - d : t + d );
+            };
+            // first window that contains t: the aligned one holding t, or an earlier one if the windows overlap
+            auto first_window = [ & ]( const Time &t ) {
+                Time start = detail::window_floor( t, slide );
+                while ( shift( t, slide ) < shift( start, size ) )
+                {
+                    if constexpr ( std::is_unsigned_v<Time> )
+                        if ( start < slide )
+                            break;
+                    start = shift( start, slide, true );
+                }
+                return start;
+            };
+
+            size_t first = 0, last = 0;
+            Time start = this->empty( ) ? Time( ) : first_window( at( 0 ) );
+            while ( true )
+            {
+                while ( first < this->size( ) && at( first ) < start )
+                    first++;
+                if ( first == this->size( ) )
+                    break;
+                if ( !( at( first ) < shift( start, size ) ) )
+                {
+                    // skip the empty windows of a gap
+                    start = first_window( at( first ) );
+                    continue;
+                }
+                last = std::max( last, first );
+                while ( last < this->size( ) && at( last ) < shift( start, size ) )
+                    last++;
+                auto elements = std::span<const T>( this->data( ) + first, last - first );
+                ret.push_back( { start, shift( start, size ), elements } );
+                start = shift( start, slide );
+            }
+            VROCKUTILS_TRACE_RESULT( ret );
             return ret;
         }
 
+        /// @return counter that is incremented by every method of List that modifies the List in place, used by
+        /// indexes to detect changes
+        auto inline revision( ) const -> size_t
+        {
+            return revisions;
+        }
+
         /// @brief converts the current List to a std::vector
         /// @return list as vector
-        auto inline to_vector( ) -> std::vector<T>
+        auto inline to_vector( ) const -> std::vector<T>
         {
             return std::vector<T>( this->begin( ), this->end( ) );
         }
         /// @brief converts the current List to a std::deque
         /// @return list as deque
-        auto inline to_deque( ) -> std::deque<T>
+        auto inline to_deque( ) const -> std::deque<T>
         {
             return std::deque<T>( this->begin( ), this->end( ) );
         }
         /// @brief converts the current List to a std::forward_list
         /// @return list as forward_list
-        auto inline to_forward_list( ) -> std::forward_list<T>
+        auto inline to_forward_list( ) const -> std::forward_list<T>
         {
             return std::forward_list<T>( this->begin( ), this->end( ) );
         }
         /// @brief converts the current List to a std::list
         /// @return list as std::list
-        auto inline to_list( ) -> std::list<T>
+        auto inline to_list( ) const -> std::list<T>
         {
             return std::list<T>( this->begin( ), this->end( ) );
         }
 
     private:
         /*! \cond */
-        template <class M> struct remove_pointers
+        template <class K, class C> auto extreme_by( K &key, C better ) const -> T
         {
-            typedef M type;
-        };
+            if ( this->empty( ) )
+                throw std::runtime_error( "List is empty" );
+            size_t best = 0;
+            auto best_key = detail::key_t<K, T>( std::invoke( key, this->front( ) ) );
+            for ( size_t i = 1; i < this->size( ); i++ )
+            {
+                auto k = detail::key_t<K, T>( std::invoke( key, ( *this )[ i ] ) );
+                if ( better( k, best_key ) )
+                {
+                    best = i;
+                    best_key = std::move( k );
+                }
+            }
+            return ( *this )[ best ];
+        }
 
-        template <typename M, typename N> struct remove_pointers<N M::*>
+        auto compare_filter( kernels::Compare op, T a, T b ) const -> List
         {
-            typedef N type;
-        };
+            auto ret = List( this->get_allocator( ) );
+            ret.resize( this->size( ) );
+            if constexpr ( detail::has_kernel<T> )
+                ret.resize( kernels::filter( this->data( ), this->size( ), op, a, b, ret.data( ) ) );
+            else
+            {
+                size_t k = 0;
+                for ( auto v : *this )
+                {
+                    bool keep = false;
+                    switch ( op )
+                    {
+                    case kernels::Compare::less:
+                        keep = less( v, a );
+                        break;
+                    case kernels::Compare::greater:
+                        keep = less( a, v );
+                        break;
+                    case kernels::Compare::equal:
+                        keep = !less( v, a ) && !less( a, v );
+                        break;
+                    case kernels::Compare::between:
+                        keep = !less( v, a ) && !less( b, v );
+                        break;
+                    }
+                    if ( keep )
+                        ret[ k++ ] = v;
+                }
+                ret.resize( k );
+            }
+            return ret;
+        }
+
+        template <class R, class KL, class KR, class RA>
+        auto filter_by_keys( const List<R, RA> &o, KL &left_key, KR &right_key, bool keep_matches ) const -> List
+        {
+            using K = std::common_type_t<detail::key_t<KL, T>, detail::key_t<KR, R>>;
+            auto keys = std::unordered_set<K, detail::key_hash<K>>( );
+            keys.reserve( o.size( ) );
+            for ( const auto &r : o )
+                keys.emplace( std::invoke( right_key, r ) );
+            auto ret = List( this->get_allocator( ) );
+            for ( const auto &l : *this )
+                if ( ( keys.find( K( std::invoke( left_key, l ) ) ) != keys.end( ) ) == keep_matches )
+                    ret.push_back( l );
+            return ret;
+        }
+
+        template <class K, class V, class C> auto group_extreme( K &key, V &value, C better ) const
+        {
+            using value_type = detail::key_t<V, T>;
+            auto res = std::unordered_map<detail::key_t<K, T>, value_type, detail::key_hash<detail::key_t<K, T>>>( );
+            for ( const auto &e : *this )
+            {
+                auto [ it, inserted ] = res.try_emplace( std::invoke( key, e ), std::invoke( value, e ) );
+                if ( !inserted )
+                {
+                    auto &&v = std::invoke( value, e );
+                    if ( better( v, it->second ) )
+                        it->second = v;
+                }
+            }
+            return res;
+        }
+
+        /// calls emit with the sum of every complete window, adding the entering and subtracting the leaving value
+        template <class V, class F> auto sliding_sums( V &value, size_t w, size_t step, F emit ) const -> void
+        {
+            using S = detail::sum_t<detail::key_t<V, T>>;
+            if ( w == 0 || step == 0 )
+                throw std::invalid_argument( "window width and step have to be greater than zero" );
+            auto sum = detail::running_sum<S>( );
+            for ( size_t i = 0; i < this->size( ); i++ )
+            {
+                sum.add( static_cast<S>( std::invoke( value, ( *this )[ i ] ) ) );
+                if ( i >= w )
+                    sum.remove( static_cast<S>( std::invoke( value, ( *this )[ i - w ] ) ) );
+                if ( i + 1 >= w && ( i + 1 - w ) % step == 0 )
+                    emit( sum.value( ) );
+            }
+        }
+
+        /// extreme of every complete window with a monotonic deque of candidates. a candidate is dropped as soon as a
+        /// later value is at least as good, so the front is always the extreme of the window
+        template <class V, class C>
+        auto sliding_extreme( V &value, size_t w, size_t step, C better ) const -> rebind<detail::key_t<V, T>>
+        {
+            using R = detail::key_t<V, T>;
+            if ( w == 0 || step == 0 )
+                throw std::invalid_argument( "window width and step have to be greater than zero" );
+            auto ret = rebind<R>( this->get_allocator( ) );
+            if ( this->size( ) >= w )
+                ret.reserve( ( this->size( ) - w ) / step + 1 );
+            auto candidates = std::deque<std::pair<size_t, R>>( );
+            for ( size_t i = 0; i < this->size( ); i++ )
+            {
+                auto v = R( std::invoke( value, ( *this )[ i ] ) );
+                while ( !candidates.empty( ) && !better( candidates.back( ).second, v ) )
+                    candidates.pop_back( );
+                candidates.emplace_back( i, std::move( v ) );
+                if ( candidates.front( ).first + w <= i )
+                    candidates.pop_front( );
+                if ( i + 1 >= w && ( i + 1 - w ) % step == 0 )
+                    ret.push_back( candidates.front( ).second );
+            }
+            return ret;
+        }
 
         template <size_t i, size_t size, typename... R> struct tuple_less_t
         {
@@ -401,21 +1582,259 @@ namespace vrock::utils
             }
         };
 
-        template <typename... R> constexpr auto make_tuple_less( )
+        template <typename... R> static constexpr auto make_tuple_less( )
         {
             constexpr auto s = sizeof...( R );
-            return tuple_less_t<0u, s, typename remove_pointers<R>::type...>::tuple_less;
+            return tuple_less_t<0u, s, detail::key_t<R, T>...>::tuple_less;
+        }
+        /*! \endcond */
+
+        size_t revisions = 0;
+    };
+
+    /// Lazy ordering of a List created by List::order_by and List::order_by_descending.
+    ///
+    /// Every key is extracted once per element. A single integral or floating point key is sorted with a LSD radix
+    /// sort, everything else with a comparison sort on the extracted keys. take(k) keeps only the k first elements in
+    /// a bounded heap instead of sorting the whole List. Keys are compared with less(), so NaN sorts after every
+    /// number.
+    /// @tparam L type of the ordered List
+    /// @tparam Keys key selectors, the first one is the most significant
+    template <class L, class... Keys> class Ordering
+    {
+        using T = typename L::value_type;
+
+    public:
+        /// @param source List to order, has to outlive the Ordering
+        /// @param keys key selectors
+        /// @param stable keep the order of elements with equal keys
+        Ordering( const L *source, std::tuple<Keys...> keys, bool stable = false )
+            : source( source ), keys( std::move( keys ) ), is_stable( stable )
+        {
+        }
+        /// @param owned List to order, shared by the Orderings derived from this one
+        /// @param keys key selectors
+        /// @param stable keep the order of elements with equal keys
+        Ordering( std::shared_ptr<const L> owned, std::tuple<Keys...> keys, bool stable = false )
+            : owned( std::move( owned ) ), source( this->owned.get( ) ), keys( std::move( keys ) ), is_stable( stable )
+        {
+        }
+
+    public:
+        /// @param key key selector (callable or member pointer) used for elements with equal previous keys
+        /// @return Ordering with the additional ascending key
+        template <class K> auto inline then_by( K key ) const -> Ordering<L, Keys..., detail::sort_key<K, false>>
+        {
+            return Ordering<L, Keys..., detail::sort_key<K, false>>(
+                owned, source, std::tuple_cat( keys, std::make_tuple( detail::sort_key<K, false>{ key } ) ),
+                is_stable );
+        }
+        /// @param key key selector (callable or member pointer) used for elements with equal previous keys
+        /// @return Ordering with the additional descending key
+        template <class K>
+        auto inline then_by_descending( K key ) const -> Ordering<L, Keys..., detail::sort_key<K, true>>
+        {
+            return Ordering<L, Keys..., detail::sort_key<K, true>>(
+                owned, source, std::tuple_cat( keys, std::make_tuple( detail::sort_key<K, true>{ key } ) ),
+                is_stable );
+        }
+        /// @return Ordering that keeps the order of elements with equal keys
+        auto inline stable( ) const -> Ordering
+        {
+            return Ordering( owned, source, keys, true );
+        }
+        /// @return the ordered elements
+        auto inline to_list( ) const -> L
+        {
+            if constexpr ( sizeof...( Keys ) == 1 )
+            {
+                using K = key_type<0>;
+                if constexpr ( detail::radix_sortable<K> )
+                    if ( source->size( ) >= radix_threshold )
+                    {
+                        VROCKUTILS_TRACE_OP( "List::order_by(key)", source->size( ) );
+                        auto ret = radix_sort( );
+                        VROCKUTILS_TRACE_RESULT( ret );
+                        return ret;
+                    }
+            }
+            VROCKUTILS_TRACE_OP( "List::order_by(key)", source->size( ) );
+            auto entries = extract( );
+            auto cmp = [ this ]( const entry &a, const entry &b ) { return compare( a, b ) < 0; };
+            if ( is_stable )
+                std::stable_sort( entries.begin( ), entries.end( ), cmp );
+            else
+                std::sort( entries.begin( ), entries.end( ), cmp );
+            auto ret = gather( entries );
+            VROCKUTILS_TRACE_RESULT( ret );
+            return ret;
+        }
+        /// @brief returns the first k elements of the ordering without sorting the whole List. equal elements keep
+        /// their order
+        /// @param k amount of elements to take
+        /// @return List with the k first elements
+        auto inline take( size_t k ) const -> L
+        {
+            if ( k >= source->size( ) )
+                return stable( ).to_list( );
+            VROCKUTILS_TRACE_OP( "List::order_by(key).take", source->size( ) );
+            // max heap of the k best entries seen so far, the worst one is on top
+            auto cmp = [ this ]( const entry &a, const entry &b ) {
+                auto c = compare( a, b );
+                return c != 0 ? c < 0 : a.index < b.index;
+            };
+            auto heap = std::vector<entry>( );
+            heap.reserve( k + 1 );
+            for ( size_t i = 0; i < source->size( ) && k > 0; i++ )
+            {
+                auto e = make_entry( i );
+                if ( heap.size( ) < k )
+                {
+                    heap.push_back( std::move( e ) );
+                    std::push_heap( heap.begin( ), heap.end( ), cmp );
+                }
+                else if ( cmp( e, heap.front( ) ) )
+                {
+                    std::pop_heap( heap.begin( ), heap.end( ), cmp );
+                    heap.back( ) = std::move( e );
+                    std::push_heap( heap.begin( ), heap.end( ), cmp );
+                }
+            }
+            std::sort_heap( heap.begin( ), heap.end( ), cmp );
+            auto ret = gather( heap );
+            VROCKUTILS_TRACE_RESULT( ret );
+            return ret;
+        }
+        /// @return the ordered elements
+        operator L( ) const
+        {
+            return to_list( );
+        }
+
+    private:
+        /*! \cond */
+        template <class, class...> friend class Ordering;
+
+        Ordering( std::shared_ptr<const L> owned, const L *source, std::tuple<Keys...> keys, bool stable )
+            : owned( std::move( owned ) ), source( source ), keys( std::move( keys ) ), is_stable( stable )
+        {
+        }
+
+        static constexpr size_t radix_threshold = 256;
+
+        template <size_t I>
+        using key_type = detail::key_t<decltype( std::tuple_element_t<I, std::tuple<Keys...>>::selector ), T>;
+
+        template <class S> struct is_descending;
+        template <class S, bool D> struct is_descending<detail::sort_key<S, D>> : std::bool_constant<D>
+        {
+        };
+
+        struct entry
+        {
+            std::tuple<detail::key_t<decltype( Keys::selector ), T>...> key;
+            size_t index;
+        };
+
+        auto make_entry( size_t i ) const -> entry
+        {
+            const auto &e = ( *source )[ i ];
+            return entry{ std::apply(
+                              [ & ]( const auto &...k ) {
+                                  return std::tuple<detail::key_t<decltype( Keys::selector ), T>...>(
+                                      std::invoke( k.selector, e )... );
+                              },
+                              keys ),
+                          i };
+        }
+
+        auto extract( ) const -> std::vector<entry>
+        {
+            auto entries = std::vector<entry>( );
+            entries.reserve( source->size( ) );
+            for ( size_t i = 0; i < source->size( ); i++ )
+                entries.push_back( make_entry( i ) );
+            return entries;
+        }
+
+        template <size_t I = 0> auto compare( const entry &a, const entry &b ) const -> int
+        {
+            if constexpr ( I == sizeof...( Keys ) )
+                return 0;
+            else
+            {
+                const auto &x = std::get<I>( a.key );
+                const auto &y = std::get<I>( b.key );
+                constexpr int dir = is_descending<std::tuple_element_t<I, std::tuple<Keys...>>>::value ? -1 : 1;
+                if ( less( x, y ) )
+                    return -dir;
+                if ( less( y, x ) )
+                    return dir;
+                return compare<I + 1>( a, b );
+            }
+        }
+
+        template <class C> auto gather( const C &entries ) const -> L
+        {
+            auto ret = L( source->get_allocator( ) );
+            ret.reserve( entries.size( ) );
+            for ( const auto &e : entries )
+                ret.push_back( ( *source )[ e.index ] );
+            return ret;
+        }
+
+        auto radix_sort( ) const -> L
+        {
+            using K = key_type<0>;
+            using U = decltype( detail::radix_key( K( ) ) );
+            constexpr bool descending = is_descending<std::tuple_element_t<0, std::tuple<Keys...>>>::value;
+            const auto &selector = std::get<0>( keys ).selector;
+            const size_t n = source->size( );
+
+            auto items = std::vector<std::pair<U, size_t>>( n );
+            for ( size_t i = 0; i < n; i++ )
+            {
+                U u = detail::radix_key( K( std::invoke( selector, ( *source )[ i ] ) ) );
+                items[ i ] = { descending ? U( ~u ) : u, i };
+            }
+            // LSD passes over 8 bit digits, passes where every element has the same digit are skipped
+            auto buffer = std::vector<std::pair<U, size_t>>( n );
+            for ( size_t shift = 0; shift < sizeof( U ) * 8; shift += 8 )
+            {
+                size_t counts[ 257 ] = { };
+                for ( const auto &item : items )
+                    counts[ ( ( item.first >> shift ) & 0xff ) + 1 ]++;
+                if ( counts[ ( ( items[ 0 ].first >> shift ) & 0xff ) + 1 ] == n )
+                    continue;
+                for ( size_t d = 1; d < 257; d++ )
+                    counts[ d ] += counts[ d - 1 ];
+                for ( const auto &item : items )
+                    buffer[ counts[ ( item.first >> shift ) & 0xff ]++ ] = item;
+                items.swap( buffer );
+            }
+            auto ret = L( source->get_allocator( ) );
+            ret.reserve( n );
+            for ( const auto &item : items )
+                ret.push_back( ( *source )[ item.second ] );
+            return ret;
         }
         /*! \endcond */
+
+        /// set if the Ordering was created from a temporary List
+        std::shared_ptr<const L> owned;
+        const L *source;
+        std::tuple<Keys...> keys;
+        bool is_stable;
     };
 
     /// @brief flattens the given list
     /// @tparam T type of the List Lists
     /// @param list collection of lists to flatten
-    /// @return flattened List
-    template <class T> auto select_many( List<List<T>> const &list ) -> List<T>
+    /// @return flattened List, using the allocator of the outer List rebound to T
+    template <class T, class A, class AA>
+    auto select_many( List<List<T, A>, AA> const &list ) -> typename List<List<T, A>, AA>::template rebind<T>
     {
-        List<T> flattened;
+        auto flattened = typename List<List<T, A>, AA>::template rebind<T>( list.get_allocator( ) );
         for ( auto const &l : list )
             flattened.insert( flattened.end( ), l.begin( ), l.end( ) );
         return flattened;
@@ -425,11 +1844,24 @@ namespace vrock::utils
     /// @tparam T type of the List Lists
     /// @param list collection of lists to flatten
     /// @return flattened List
-    template <class T> auto select_many( List<std::vector<T>> const &list ) -> List<T>
+    template <class T, class A, class AA>
+    auto select_many( List<std::vector<T, A>, AA> const &list )
+        -> typename List<std::vector<T, A>, AA>::template rebind<T>
     {
-        List<T> flattened;
+        auto flattened = typename List<std::vector<T, A>, AA>::template rebind<T>( list.get_allocator( ) );
         for ( auto const &v : list )
             flattened.insert( flattened.end( ), v.begin( ), v.end( ) );
         return flattened;
     }
-} // namespace vrock::utils
\ No newline at end of file
+
+    namespace pmr
+    {
+        /// List whose elements and query results are allocated from a std::pmr::memory_resource, e.g. an arena
+        /// shared by all temporaries of a query
+        template <class T> using List = vrock::utils::List<T, std::pmr::polymorphic_allocator<T>>;
+    } // namespace pmr
+} // namespace vrock::utils
+
+#include "Index.hpp"
+#include "Sketch.hpp"
+#include "Window.hpp"
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "vrockutils_conf.h"
+
+namespace vrock::utils::kernels
+{
+    /// comparison used by the filter kernels. NaN is ordered like in less(): it compares greater than every number
+    enum class Compare
+    {
+        /// value < a
+        less,
+        /// value > a
+        greater,
+        /// value == a
+        equal,
+        /// a <= value <= b
+        between
+    };
+
+    /// @return true if the cpu supports AVX2 and the AVX2 kernels were compiled in
+    VROCKUTILS_API auto has_avx2( ) -> bool;
+    /// enables or disables the vectorized kernels at runtime. they are enabled by default if the cpu supports them
+    VROCKUTILS_API auto set_simd_enabled( bool enabled ) -> void;
+    /// @return true if the vectorized kernels are used
+    VROCKUTILS_API auto simd_enabled( ) -> bool;
+
+    /// @return sum of the n values
+    VROCKUTILS_API auto sum( const int32_t *data, size_t n ) -> int64_t;
+    /// @return sum of the n values
+    VROCKUTILS_API auto sum( const int64_t *data, size_t n ) -> int64_t;
+    /// @return sum of the n values, accumulated in double precision
+    VROCKUTILS_API auto sum( const float *data, size_t n ) -> double;
+    /// @return sum of the n values
+    VROCKUTILS_API auto sum( const double *data, size_t n ) -> double;
+
+    /// @return smallest of the n values, n has to be greater than zero. NaN is only returned if all values are NaN
+    VROCKUTILS_API auto min( const int32_t *data, size_t n ) -> int32_t;
+    /// @return smallest of the n values, n has to be greater than zero. NaN is only returned if all values are NaN
+    VROCKUTILS_API auto min( const int64_t *data, size_t n ) -> int64_t;
+    /// @return smallest of the n values, n has to be greater than zero. NaN is only returned if all values are NaN
+    VROCKUTILS_API auto min( const float *data, size_t n ) -> float;
+    /// @return smallest of the n values, n has to be greater than zero. NaN is only returned if all values are NaN
+    VROCKUTILS_API auto min( const double *data, size_t n ) -> double;
+
+    /// @return largest of the n values, n has to be greater than zero. NaN is returned if any value is NaN
+    VROCKUTILS_API auto max( const int32_t *data, size_t n ) -> int32_t;
+    /// @return largest of the n values, n has to be greater than zero. NaN is returned if any value is NaN
+    VROCKUTILS_API auto max( const int64_t *data, size_t n ) -> int64_t;
+    /// @return largest of the n values, n has to be greater than zero. NaN is returned if any value is NaN
+    VROCKUTILS_API auto max( const float *data, size_t n ) -> float;
+    /// @return largest of the n values, n has to be greater than zero. NaN is returned if any value is NaN
+    VROCKUTILS_API auto max( const double *data, size_t n ) -> double;
+
+    /// @brief copies all values matching the comparison to out, keeping their order
+    /// @param out has to have room for n values, may be the same as data
+    /// @return amount of values written to out
+    VROCKUTILS_API auto filter( const int32_t *data, size_t n, Compare op, int32_t a, int32_t b, int32_t *out )
+        -> size_t;
+    /// @brief copies all values matching the comparison to out, keeping their order
+    /// @param out has to have room for n values, may be the same as data
+    /// @return amount of values written to out
+    VROCKUTILS_API auto filter( const int64_t *data, size_t n, Compare op, int64_t a, int64_t b, int64_t *out )
+        -> size_t;
+    /// @brief copies all values matching the comparison to out, keeping their order
+    /// @param out has to have room for n values, may be the same as data
+    /// @return amount of values written to out
+    VROCKUTILS_API auto filter( const float *data, size_t n, Compare op, float a, float b, float *out ) -> size_t;
+    /// @brief copies all values matching the comparison to out, keeping their order
+    /// @param out has to have room for n values, may be the same as data
+    /// @return amount of values written to out
+    VROCKUTILS_API auto filter( const double *data, size_t n, Compare op, double a, double b, double *out ) -> size_t;
+} // namespace vrock::utils::kernels
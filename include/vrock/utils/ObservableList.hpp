@@ -0,0 +1,224 @@
+#pragma once
+
+#include "List.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace vrock::utils
+{
+    template <class T> class ObservableList;
+
+    /// Receives the changes of an ObservableList.
+    ///
+    /// An observer is attached to at most one list. It detaches itself when it is destroyed and is detached when the
+    /// list is destroyed.
+    /// @tparam T type of the list elements
+    template <class T> class ListObserver
+    {
+    public:
+        ListObserver( ) = default;
+        ListObserver( const ListObserver & ) = delete;
+        auto operator=( const ListObserver & ) -> ListObserver & = delete;
+        virtual ~ListObserver( )
+        {
+            if ( source )
+                source->unsubscribe( *this );
+        }
+
+        /// called after e was inserted at position pos
+        virtual auto on_insert( const T &e, size_t pos ) -> void = 0;
+        /// called before e is removed from position pos
+        virtual auto on_erase( const T &e, size_t pos ) -> void = 0;
+        /// called before erase_if removes the elements at positions (ascending) at once. the List still contains all
+        /// of them. the default calls on_erase for each of them from the back to the front, an observer that reads the
+        /// List while handling an erase has to override this to skip every removed element
+        virtual auto on_erase_batch( const List<T> &elements, const std::vector<size_t> &positions ) -> void
+        {
+            for ( size_t r = positions.size( ); r-- > 0; )
+                on_erase( elements[ positions[ r ] ], positions[ r ] );
+        }
+        /// called before all elements are removed. the default erases every element
+        virtual auto on_clear( const List<T> &elements ) -> void
+        {
+            for ( size_t i = elements.size( ); i-- > 0; )
+                on_erase( elements[ i ], i );
+        }
+
+        /// @return the list this observer is attached to or nullptr
+        auto observed( ) const -> const ObservableList<T> *
+        {
+            return source;
+        }
+
+    private:
+        friend class ObservableList<T>;
+        ObservableList<T> *source = nullptr;
+    };
+
+    /// List that notifies observers about every change made through its own API.
+    ///
+    /// The elements can be read and queried through list( ), changes have to go through the methods of this class so
+    /// that the attached views and indexes stay up to date.
+    /// @tparam T type of the elements
+    template <class T> class ObservableList
+    {
+    public:
+        /// @param elements initial elements
+        explicit ObservableList( List<T> elements = List<T>( ) ) : elements( std::move( elements ) )
+        {
+        }
+        ObservableList( const ObservableList & ) = delete;
+        auto operator=( const ObservableList & ) -> ObservableList & = delete;
+        ~ObservableList( )
+        {
+            for ( auto *o : observers )
+                o->source = nullptr;
+        }
+
+    public:
+        /// @return the elements, for queries
+        auto list( ) const -> const List<T> &
+        {
+            return elements;
+        }
+        /// @return amount of elements
+        auto count( ) const -> size_t
+        {
+            return elements.size( );
+        }
+        /// @return element at position i
+        auto operator[]( size_t i ) const -> const T &
+        {
+            return elements[ i ];
+        }
+
+        /// @brief attaches an observer. the observer receives an insert for every existing element
+        /// @param o observer, must not be attached to another list
+        auto subscribe( ListObserver<T> &o ) -> void
+        {
+            if ( o.source == this )
+                return;
+            if ( o.source != nullptr )
+                throw std::logic_error( "observer is already attached to another list" );
+            o.source = this;
+            observers.push_back( &o );
+            for ( size_t i = 0; i < elements.size( ); i++ )
+                o.on_insert( elements[ i ], i );
+        }
+        /// @brief detaches an observer, it receives no further changes
+        auto unsubscribe( ListObserver<T> &o ) -> void
+        {
+            observers.erase( std::remove( observers.begin( ), observers.end( ), &o ), observers.end( ) );
+            o.source = nullptr;
+        }
+
+        /// appends e
+        auto push_back( T e ) -> void
+        {
+            elements.push_back( std::move( e ) );
+            notify_insert( elements.size( ) - 1 );
+        }
+        /// constructs an element in place at the end
+        template <class... Args> auto emplace_back( Args &&...args ) -> const T &
+        {
+            elements.emplace_back( std::forward<Args>( args )... );
+            notify_insert( elements.size( ) - 1 );
+            return elements.back( );
+        }
+        /// appends all elements of l
+        auto append( const List<T> &l ) -> void
+        {
+            elements.reserve( elements.size( ) + l.size( ) );
+            for ( const auto &e : l )
+                push_back( e );
+        }
+        /// inserts e at position pos
+        auto insert( size_t pos, T e ) -> void
+        {
+            if ( pos > elements.size( ) )
+                throw std::out_of_range( "out of bounds" );
+            elements.insert( elements.begin( ) + static_cast<std::ptrdiff_t>( pos ), std::move( e ) );
+            notify_insert( pos );
+        }
+        /// replaces the element at position pos, observers see an erase followed by an insert
+        auto set( size_t pos, T e ) -> void
+        {
+            if ( pos >= elements.size( ) )
+                throw std::out_of_range( "out of bounds" );
+            notify_erase( pos );
+            elements[ pos ] = std::move( e );
+            notify_insert( pos );
+        }
+        /// removes the element at position pos
+        auto erase( size_t pos ) -> void
+        {
+            if ( pos >= elements.size( ) )
+                throw std::out_of_range( "out of bounds" );
+            notify_erase( pos );
+            elements.erase( elements.begin( ) + static_cast<std::ptrdiff_t>( pos ) );
+        }
+        /// removes all elements complying with the expression in O( n ). observers are notified once with all
+        /// removed positions (see ListObserver::on_erase_batch) before the List is compacted
+        /// @return amount of removed elements
+        template <class P> auto erase_if( P exp ) -> size_t
+        {
+            auto removed = std::vector<size_t>( );
+            for ( size_t i = 0; i < elements.size( ); i++ )
+                if ( exp( elements[ i ] ) )
+                    removed.push_back( i );
+            if ( removed.empty( ) )
+                return 0;
+            for ( auto *o : observers )
+                o->on_erase_batch( elements, removed );
+            // compact the kept elements in one pass and erase the tail once
+            size_t out = removed.front( ), next = 0;
+            for ( size_t i = removed.front( ); i < elements.size( ); i++ )
+            {
+                if ( next < removed.size( ) && removed[ next ] == i )
+                {
+                    next++;
+                    continue;
+                }
+                elements[ out++ ] = std::move( elements[ i ] );
+            }
+            elements.erase( elements.begin( ) + static_cast<std::ptrdiff_t>( out ), elements.end( ) );
+            return removed.size( );
+        }
+        /// removes the last element
+        auto pop_back( ) -> void
+        {
+            if ( elements.empty( ) )
+                throw std::out_of_range( "List is empty" );
+            erase( elements.size( ) - 1 );
+        }
+        /// removes all elements
+        auto clear( ) -> void
+        {
+            for ( auto *o : observers )
+                o->on_clear( elements );
+            elements.clear( );
+        }
+
+    private:
+        /*! \cond */
+        auto notify_insert( size_t pos ) -> void
+        {
+            for ( auto *o : observers )
+                o->on_insert( elements[ pos ], pos );
+        }
+
+        auto notify_erase( size_t pos ) -> void
+        {
+            for ( auto *o : observers )
+                o->on_erase( elements[ pos ], pos );
+        }
+        /*! \endcond */
+
+        List<T> elements;
+        std::vector<ListObserver<T> *> observers;
+    };
+} // namespace vrock::utils
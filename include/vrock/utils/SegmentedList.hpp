@@ -0,0 +1,483 @@
+#pragma once
+
+#include "List.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vrock::utils
+{
+    /// default amount of bytes per chunk of a SegmentedList
+    constexpr size_t default_segment_bytes = 64 * 1024;
+
+    /// List stored in fixed size chunks with a directory, for very large datasets.
+    ///
+    /// Appending never relocates elements: a full chunk stays where it is and a new one is started, so element
+    /// addresses are stable and growing never needs twice the memory. Chunks can be processed in parallel and
+    /// concat / select_many splice whole chunks instead of copying elements. Chunks taken over from another
+    /// SegmentedList may be partially filled, the directory keeps the index of the first element of every chunk.
+    /// @tparam T type of the elements
+    template <class T> class SegmentedList
+    {
+        template <bool Const> class basic_iterator;
+
+    public:
+        using value_type = T;
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        /// @param chunk_size amount of elements per chunk, defaults to default_segment_bytes worth of elements
+        explicit SegmentedList( size_t chunk_size = std::max<size_t>( 1, default_segment_bytes / sizeof( T ) ) )
+            : chunk_size( std::max<size_t>( 1, chunk_size ) )
+        {
+        }
+        /// @param list elements to copy
+        /// @param chunk_size amount of elements per chunk
+        explicit SegmentedList( const List<T> &list,
+                                size_t chunk_size = std::max<size_t>( 1, default_segment_bytes / sizeof( T ) ) )
+            : SegmentedList( chunk_size )
+        {
+            for ( const auto &e : list )
+                push_back( e );
+        }
+
+    public:
+        /// @return amount of elements
+        auto size( ) const -> size_t
+        {
+            return total;
+        }
+        /// @return amount of elements
+        auto count( ) const -> size_t
+        {
+            return total;
+        }
+        /// @return true if there are no elements
+        auto empty( ) const -> bool
+        {
+            return total == 0;
+        }
+        /// @return amount of elements per newly started chunk
+        auto get_chunk_size( ) const -> size_t
+        {
+            return chunk_size;
+        }
+        /// @return amount of chunks
+        auto chunk_count( ) const -> size_t
+        {
+            return chunks.size( );
+        }
+        /// @return the elements of chunk i
+        auto chunk( size_t i ) -> std::span<T>
+        {
+            return std::span<T>( chunks[ i ] );
+        }
+        /// @return the elements of chunk i
+        auto chunk( size_t i ) const -> std::span<const T>
+        {
+            return std::span<const T>( chunks[ i ] );
+        }
+
+        /// @return element at position i, O(1) while all chunks are full and O(log chunks) after splicing
+        auto operator[]( size_t i ) -> T &
+        {
+            auto [ c, o ] = locate( i );
+            return chunks[ c ][ o ];
+        }
+        /// @return element at position i, O(1) while all chunks are full and O(log chunks) after splicing
+        auto operator[]( size_t i ) const -> const T &
+        {
+            auto [ c, o ] = locate( i );
+            return chunks[ c ][ o ];
+        }
+        /// @return element at position i. throws an exception if i is out of range
+        auto at( size_t i ) -> T &
+        {
+            if ( i >= total )
+                throw std::out_of_range( "out of bounds" );
+            return ( *this )[ i ];
+        }
+        /// @return element at position i. throws an exception if i is out of range
+        auto at( size_t i ) const -> const T &
+        {
+            if ( i >= total )
+                throw std::out_of_range( "out of bounds" );
+            return ( *this )[ i ];
+        }
+
+        auto begin( ) -> iterator
+        {
+            return iterator( &chunks, 0, 0 );
+        }
+        auto end( ) -> iterator
+        {
+            return iterator( &chunks, chunks.size( ), 0 );
+        }
+        auto begin( ) const -> const_iterator
+        {
+            return const_iterator( &chunks, 0, 0 );
+        }
+        auto end( ) const -> const_iterator
+        {
+            return const_iterator( &chunks, chunks.size( ), 0 );
+        }
+
+        /// appends e, never moves existing elements
+        auto push_back( T e ) -> T &
+        {
+            return emplace_back( std::move( e ) );
+        }
+        /// constructs an element in place at the end, never moves existing elements
+        template <class... Args> auto emplace_back( Args &&...args ) -> T &
+        {
+            if ( chunks.empty( ) || chunks.back( ).size( ) >= chunk_size ||
+                 chunks.back( ).size( ) == chunks.back( ).capacity( ) )
+            {
+                if ( !chunks.empty( ) && chunks.back( ).size( ) != chunk_size )
+                    uniform = false;
+                starts.push_back( total );
+                chunks.emplace_back( );
+                chunks.back( ).reserve( chunk_size );
+            }
+            chunks.back( ).emplace_back( std::forward<Args>( args )... );
+            total++;
+            return chunks.back( ).back( );
+        }
+        /// removes the last element
+        auto pop_back( ) -> void
+        {
+            if ( empty( ) )
+                throw std::out_of_range( "List is empty" );
+            chunks.back( ).pop_back( );
+            total--;
+            if ( chunks.back( ).empty( ) )
+            {
+                chunks.pop_back( );
+                starts.pop_back( );
+            }
+        }
+        /// removes all elements and chunks
+        auto clear( ) -> void
+        {
+            chunks.clear( );
+            starts.clear( );
+            total = 0;
+            uniform = true;
+        }
+        /// @brief moves the chunks of o to the end of this List without copying or moving elements. addresses of the
+        /// elements of o stay valid
+        /// @return this List
+        auto concat( SegmentedList &&o ) -> SegmentedList &
+        {
+            if ( o.empty( ) )
+                return *this;
+            if ( !chunks.empty( ) && chunks.back( ).size( ) != chunk_size )
+                uniform = false;
+            for ( auto &c : o.chunks )
+            {
+                if ( &c == &o.chunks.back( ) ? c.size( ) > chunk_size : c.size( ) != chunk_size )
+                    uniform = false;
+                starts.push_back( total );
+                total += c.size( );
+                chunks.push_back( std::move( c ) );
+            }
+            o.clear( );
+            return *this;
+        }
+
+        /// applies an expression on every element
+        template <class F> auto for_each( F exp ) const -> void
+        {
+            for ( const auto &c : chunks )
+                std::for_each( c.begin( ), c.end( ), exp );
+        }
+        /// @brief applies an expression on every chunk
+        /// @param exp expression that takes the elements of a chunk (std::span) and the index of its first element
+        template <class F> auto for_each_chunk( F exp ) -> void
+        {
+            for ( size_t c = 0; c < chunks.size( ); c++ )
+                exp( std::span<T>( chunks[ c ] ), starts[ c ] );
+        }
+        /// @brief applies an expression on every chunk, the chunks are distributed over multiple threads. the first
+        /// exception thrown by exp is rethrown after all threads finished
+        /// @param exp expression that takes the elements of a chunk (std::span) and the index of its first element
+        /// @param threads amount of threads, 0 uses std::thread::hardware_concurrency
+        template <class F> auto parallel_for_each_chunk( F exp, size_t threads = 0 ) -> void
+        {
+            if ( threads == 0 )
+                threads = std::max<unsigned>( 1, std::thread::hardware_concurrency( ) );
+            threads = std::min( threads, chunks.size( ) );
+            if ( threads <= 1 )
+                return for_each_chunk( exp );
+
+            auto next = std::atomic<size_t>( 0 );
+            auto error = std::exception_ptr( );
+            auto error_mutex = std::mutex( );
+            auto work = [ & ]( ) {
+                for ( size_t c; ( c = next.fetch_add( 1 ) ) < chunks.size( ); )
+                {
+                    try
+                    {
+                        exp( std::span<T>( chunks[ c ] ), starts[ c ] );
+                    }
+                    catch ( ... )
+                    {
+                        auto lock = std::lock_guard( error_mutex );
+                        if ( !error )
+                            error = std::current_exception( );
+                        next = chunks.size( );
+                    }
+                }
+            };
+            auto workers = std::vector<std::thread>( );
+            workers.reserve( threads - 1 );
+            for ( size_t t = 1; t < threads; t++ )
+                workers.emplace_back( work );
+            work( );
+            for ( auto &w : workers )
+                w.join( );
+            if ( error )
+                std::rethrow_exception( error );
+        }
+        /// @brief applies an expression on every element, the chunks are distributed over multiple threads
+        /// @param exp expression that takes a reference to the element
+        /// @param threads amount of threads, 0 uses std::thread::hardware_concurrency
+        template <class F> auto parallel_for_each( F exp, size_t threads = 0 ) -> void
+        {
+            parallel_for_each_chunk(
+                [ &exp ]( std::span<T> c, size_t ) {
+                    for ( auto &e : c )
+                        exp( e );
+                },
+                threads );
+        }
+
+        /// applies an aggregate function on the List
+        /// @param exp aggregate function to use. it takes the element and the value of the runs before. returns the
+        /// new value
+        /// @return result after the aggregate function was run on every element
+        template <class R, class F> auto aggregate( F exp ) const -> R
+        {
+            R ret = R( );
+            for_each( [ & ]( const T &e ) { ret = exp( e, std::move( ret ) ); } );
+            return ret;
+        }
+        /// @return amount of elements complying with the expression
+        template <class P> auto count( P exp ) const -> size_t
+        {
+            size_t ret = 0;
+            for_each( [ & ]( const T &e ) { ret += exp( e ) ? 1 : 0; } );
+            return ret;
+        }
+        /// checks if the List contains any element
+        auto any( ) const -> bool
+        {
+            return !empty( );
+        }
+        /// checks if any element complies with the expression
+        template <class P> auto any( P exp ) const -> bool
+        {
+            return std::find_if( begin( ), end( ), exp ) != end( );
+        }
+        /// checks if all elements comply with the expression
+        template <class P> auto all( P exp ) const -> bool
+        {
+            return std::find_if_not( begin( ), end( ), exp ) == end( );
+        }
+        /// checks if a given value is contained in the List
+        auto contains( const T &val ) const -> bool
+        {
+            return std::find( begin( ), end( ), val ) != end( );
+        }
+        /// Get the first element conforming to an expression. if no element conforms throw an exception
+        template <class P> auto first( P exp ) const -> T
+        {
+            auto res = std::find_if( begin( ), end( ), exp );
+            if ( res == end( ) )
+                throw std::runtime_error( "No element matching predicate found" );
+            return *res;
+        }
+        /// Get the first element conforming to an expression. if no element conforms return a default value
+        template <class P> auto first_or_default( P exp, T _default = T( ) ) const -> T
+        {
+            auto res = std::find_if( begin( ), end( ), exp );
+            return res == end( ) ? _default : *res;
+        }
+        /// Get the last element conforming to an expression. if no element conforms throw an exception
+        template <class P> auto last( P exp ) const -> T
+        {
+            for ( size_t c = chunks.size( ); c-- > 0; )
+            {
+                auto res = std::find_if( chunks[ c ].rbegin( ), chunks[ c ].rend( ), exp );
+                if ( res != chunks[ c ].rend( ) )
+                    return *res;
+            }
+            throw std::runtime_error( "No element matching predicate found" );
+        }
+        /// @brief apply a filter (exp) to the List
+        /// @param exp expression to decide if an element should be in the resulting List
+        /// @return List with all elements complying to the expression
+        template <class P> auto where( P exp ) const -> SegmentedList
+        {
+            auto ret = SegmentedList( chunk_size );
+            for_each( [ & ]( const T &e ) {
+                if ( exp( e ) )
+                    ret.push_back( e );
+            } );
+            return ret;
+        }
+        /// @brief selects all elements and applies the given expression
+        /// @param exp expression which takes an element of type T and returns the new element
+        /// @return List with all elements, chunks hold the same amount of bytes as the chunks of this List
+        template <class F>
+        auto select( F exp ) const -> SegmentedList<std::decay_t<std::invoke_result_t<F &, const T &>>>
+        {
+            using R = std::decay_t<std::invoke_result_t<F &, const T &>>;
+            auto ret = SegmentedList<R>( std::max<size_t>( 1, chunk_size * sizeof( T ) / sizeof( R ) ) );
+            for_each( [ & ]( const T &e ) { ret.push_back( exp( e ) ); } );
+            return ret;
+        }
+        /// @param a amount to skip
+        /// @return List without the first a elements
+        auto skip( size_t a ) const -> SegmentedList
+        {
+            auto ret = SegmentedList( chunk_size );
+            for ( size_t i = a; i < total; i++ )
+                ret.push_back( ( *this )[ i ] );
+            return ret;
+        }
+        /// @param a amount of elements to take
+        /// @return List with the first a elements
+        auto take( size_t a ) const -> SegmentedList
+        {
+            auto ret = SegmentedList( chunk_size );
+            auto n = std::min( a, total );
+            for ( auto it = begin( ); n > 0; ++it, n-- )
+                ret.push_back( *it );
+            return ret;
+        }
+        /// @brief groups the List by a key
+        /// @param key key selector (callable or member pointer)
+        /// @return hash map from key to the List of elements with that key
+        template <class K> auto group_by( K key ) const
+        {
+            auto res = std::unordered_map<detail::key_t<K, T>, List<T>, detail::key_hash<detail::key_t<K, T>>>( );
+            for_each( [ & ]( const T &e ) { res[ std::invoke( key, e ) ].push_back( e ); } );
+            return res;
+        }
+        /// @return all elements as one contiguous List
+        auto to_list( ) const -> List<T>
+        {
+            auto ret = List<T>( );
+            ret.reserve( total );
+            for ( const auto &c : chunks )
+                ret.insert( ret.end( ), c.begin( ), c.end( ) );
+            return ret;
+        }
+
+    private:
+        /*! \cond */
+        template <bool Const> class basic_iterator
+        {
+            using directory =
+                std::conditional_t<Const, const std::vector<std::vector<T>>, std::vector<std::vector<T>>>;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const T *, T *>;
+            using reference = std::conditional_t<Const, const T &, T &>;
+
+            basic_iterator( ) = default;
+            basic_iterator( directory *chunks, size_t c, size_t o ) : chunks( chunks ), c( c ), o( o )
+            {
+                skip_empty( );
+            }
+
+            auto operator*( ) const -> reference
+            {
+                return ( *chunks )[ c ][ o ];
+            }
+            auto operator->( ) const -> pointer
+            {
+                return &( *chunks )[ c ][ o ];
+            }
+            auto operator++( ) -> basic_iterator &
+            {
+                o++;
+                skip_empty( );
+                return *this;
+            }
+            auto operator++( int ) -> basic_iterator
+            {
+                auto ret = *this;
+                ++*this;
+                return ret;
+            }
+            auto operator==( const basic_iterator &other ) const -> bool
+            {
+                return c == other.c && o == other.o;
+            }
+            auto operator!=( const basic_iterator &other ) const -> bool
+            {
+                return !( *this == other );
+            }
+
+        private:
+            auto skip_empty( ) -> void
+            {
+                while ( c < chunks->size( ) && o == ( *chunks )[ c ].size( ) )
+                {
+                    c++;
+                    o = 0;
+                }
+            }
+
+            directory *chunks = nullptr;
+            size_t c = 0;
+            size_t o = 0;
+        };
+
+        auto locate( size_t i ) const -> std::pair<size_t, size_t>
+        {
+            if ( uniform )
+                return { i / chunk_size, i % chunk_size };
+            auto it = std::upper_bound( starts.begin( ), starts.end( ), i ) - 1;
+            return { static_cast<size_t>( it - starts.begin( ) ), i - *it };
+        }
+        /*! \endcond */
+
+        size_t chunk_size;
+        size_t total = 0;
+        /// true while every chunk but the last holds exactly chunk_size elements
+        bool uniform = true;
+        std::vector<std::vector<T>> chunks;
+        std::vector<size_t> starts;
+    };
+
+    /// @brief flattens the given lists by splicing their chunks, no element is copied or moved
+    /// @tparam T type of the elements
+    /// @param list collection of lists to flatten, the lists are left empty
+    /// @return flattened List
+    template <class T> auto select_many( SegmentedList<SegmentedList<T>> &&list ) -> SegmentedList<T>
+    {
+        auto flattened = list.empty( ) ? SegmentedList<T>( ) : SegmentedList<T>( list[ 0 ].get_chunk_size( ) );
+        list.for_each_chunk( [ & ]( std::span<SegmentedList<T>> c, size_t ) {
+            for ( auto &l : c )
+                flattened.concat( std::move( l ) );
+        } );
+        return flattened;
+    }
+} // namespace vrock::utils
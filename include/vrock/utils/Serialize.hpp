@@ -0,0 +1,313 @@
+#pragma once
+
+#include "ByteArray.hpp"
+#include "List.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+/// @file
+/// Binary serialization of Lists into ByteArrays. Every buffer starts with a 32 byte header holding a magic number,
+/// the format version, the layout, the byte order, a type id, the element count, the payload size and a CRC32 of the
+/// payload. Numbers are stored in the byte order of the writing machine, reading data of the other byte order throws.
+
+namespace vrock::utils
+{
+    /// layout of the payload
+    enum class Layout : uint8_t
+    {
+        /// elements are copied as they are in memory, only for trivially copyable types
+        raw = 0,
+        /// the members of every element are stored one after another
+        rows = 1,
+        /// all values of the first member, then all values of the second member, ...
+        columns = 2
+    };
+
+    /*! \cond */
+    namespace detail
+    {
+        struct SerialHeader
+        {
+            uint32_t magic;
+            uint16_t version;
+            uint8_t layout;
+            uint8_t endian;
+            uint32_t type_id;
+            uint32_t crc;
+            uint64_t count;
+            uint64_t payload;
+        };
+        static_assert( sizeof( SerialHeader ) == 32 );
+
+        /// the payload starts after the header, 32 bytes keep it aligned for every fundamental type
+        constexpr size_t serial_header_size = sizeof( SerialHeader );
+
+        VROCKUTILS_API auto write_header( uint8_t *data, Layout layout, uint32_t type_id, uint64_t count,
+                                          uint64_t payload ) -> void;
+        VROCKUTILS_API auto read_header( const uint8_t *data, size_t length, uint32_t type_id, bool verify )
+            -> SerialHeader;
+
+        inline auto varint_size( uint64_t v ) -> size_t
+        {
+            size_t n = 1;
+            while ( v >= 0x80 )
+            {
+                v >>= 7;
+                n++;
+            }
+            return n;
+        }
+
+        inline auto write_varint( uint8_t *&p, uint64_t v ) -> void
+        {
+            while ( v >= 0x80 )
+            {
+                *p++ = static_cast<uint8_t>( v | 0x80 );
+                v >>= 7;
+            }
+            *p++ = static_cast<uint8_t>( v );
+        }
+
+        VROCKUTILS_API auto read_varint( const uint8_t *&p, const uint8_t *end ) -> uint64_t;
+
+        /// the low 24 bits of a raw type id hold the element size
+        constexpr uint32_t raw_size_mask = 0xffffff;
+
+        /// type id of the raw layout: element size, alignment and whether T is a floating point, signed or integral
+        /// type, so e.g. ints are not read back as floats of the same size
+        template <class T> constexpr auto raw_type_id( ) -> uint32_t
+        {
+            static_assert( sizeof( T ) <= raw_size_mask, "element type is too large for the raw layout" );
+            return static_cast<uint32_t>( sizeof( T ) ) |
+                   static_cast<uint32_t>( std::countr_zero( alignof( T ) ) ) << 24 |
+                   static_cast<uint32_t>( std::is_floating_point_v<T> ) << 29 |
+                   static_cast<uint32_t>( std::is_signed_v<T> ) << 30 |
+                   static_cast<uint32_t>( std::is_integral_v<T> ) << 31;
+        }
+
+        template <class M>
+        constexpr bool serializable_member = std::is_same_v<M, std::string> || std::is_trivially_copyable_v<M>;
+    } // namespace detail
+    /*! \endcond */
+
+    /// @brief computes the CRC32 (IEEE 802.3) of the given bytes
+    /// @param data first byte
+    /// @param length amount of bytes
+    /// @param crc crc of the preceding bytes, to compute the checksum of data in multiple parts
+    /// @return checksum
+    VROCKUTILS_API auto crc32( const uint8_t *data, size_t length, uint32_t crc = 0 ) -> uint32_t;
+
+    /// @brief copies the elements in one block into a ByteArray
+    /// @param list List of trivially copyable elements
+    /// @return ByteArray with header and the raw elements
+    template <class T, class A> auto to_bytes( const List<T, A> &list ) -> std::shared_ptr<ByteArray>
+    {
+        static_assert( std::is_trivially_copyable_v<T>, "use a Schema for types that are not trivially copyable" );
+        auto payload = list.size( ) * sizeof( T );
+        auto ret = std::make_shared<ByteArray>( detail::serial_header_size + payload );
+        if ( payload > 0 )
+            std::memcpy( ret->data + detail::serial_header_size, list.data( ), payload );
+        detail::write_header( ret->data, Layout::raw, detail::raw_type_id<T>( ), list.size( ), payload );
+        return ret;
+    }
+
+    /// @brief zero copy view of data written by to_bytes, e.g. a ByteArray or a memory mapped file
+    /// @param data first byte of the serialized data, the payload has to be aligned for T
+    /// @param length amount of bytes
+    /// @param verify checks the checksum of the payload
+    /// @return span over the elements, valid as long as data is
+    template <class T>
+    auto view_as( const uint8_t *data, size_t length, bool verify = true ) -> std::span<const T>
+    {
+        static_assert( std::is_trivially_copyable_v<T>, "only trivially copyable types can be viewed" );
+        auto header = detail::read_header( data, length, detail::raw_type_id<T>( ), verify );
+        if ( header.layout != static_cast<uint8_t>( Layout::raw ) )
+            throw std::runtime_error( "data is not in the raw layout" );
+        const auto *first = data + detail::serial_header_size;
+        if ( reinterpret_cast<uintptr_t>( first ) % alignof( T ) != 0 )
+            throw std::runtime_error( "data is not aligned for the element type" );
+        return { reinterpret_cast<const T *>( first ), static_cast<size_t>( header.count ) };
+    }
+
+    /// @brief zero copy view of a ByteArray written by to_bytes
+    /// @param bytes serialized data
+    /// @param verify checks the checksum of the payload
+    /// @return span over the elements, valid as long as bytes is
+    template <class T> auto view_as( const ByteArray &bytes, bool verify = true ) -> std::span<const T>
+    {
+        return view_as<T>( bytes.data, bytes.length, verify );
+    }
+
+    /// @brief copies the elements written by to_bytes into a new List
+    /// @param bytes serialized data
+    /// @return List with the elements
+    template <class T> auto from_bytes( const ByteArray &bytes ) -> List<T>
+    {
+        static_assert( std::is_trivially_copyable_v<T>, "use a Schema for types that are not trivially copyable" );
+        auto header = detail::read_header( bytes.data, bytes.length, detail::raw_type_id<T>( ), true );
+        if ( header.layout != static_cast<uint8_t>( Layout::raw ) )
+            throw std::runtime_error( "data is not in the raw layout" );
+        auto ret = List<T>( );
+        ret.resize( header.count );
+        if ( header.payload > 0 )
+            std::memcpy( ret.data( ), bytes.data + detail::serial_header_size, header.payload );
+        return ret;
+    }
+
+    /// Describes the members of a type for serialization. Members have to be trivially copyable or std::string,
+    /// strings are stored with a varint length. The type id of the header is a fingerprint of the members, so data
+    /// written with a different schema is rejected.
+    /// @tparam T type of the elements, has to be default constructible
+    /// @tparam ...M types of the members
+    template <class T, class... M> class Schema
+    {
+        static_assert( std::is_default_constructible_v<T>, "T has to be default constructible" );
+        static_assert( ( detail::serializable_member<M> && ... ), "members have to be trivially copyable or strings" );
+
+    public:
+        /// @param ...members member pointers of the serialized members
+        explicit Schema( M T::*...members ) : members( members... )
+        {
+        }
+
+        /// @brief serializes the members of all elements
+        /// @param list elements to serialize
+        /// @param layout Layout::rows or Layout::columns
+        /// @return ByteArray with header and payload
+        template <class A>
+        auto to_bytes( const List<T, A> &list, Layout layout = Layout::rows ) const -> std::shared_ptr<ByteArray>
+        {
+            if ( layout == Layout::raw )
+                throw std::invalid_argument( "a Schema writes rows or columns" );
+            size_t payload = 0;
+            for ( const auto &e : list )
+                std::apply( [ & ]( auto... m ) { ( ( payload += field_size( e.*m ) ), ... ); }, members );
+
+            auto ret = std::make_shared<ByteArray>( detail::serial_header_size + payload );
+            auto *p = ret->data + detail::serial_header_size;
+            if ( layout == Layout::rows )
+                for ( const auto &e : list )
+                    std::apply( [ & ]( auto... m ) { ( write_field( p, e.*m ), ... ); }, members );
+            else
+                std::apply(
+                    [ & ]( auto... m ) {
+                        ( [ & ] {
+                            for ( const auto &e : list )
+                                write_field( p, e.*m );
+                        }( ),
+                          ... );
+                    },
+                    members );
+            detail::write_header( ret->data, layout, type_id( ), list.size( ), payload );
+            return ret;
+        }
+
+        /// @brief reads elements written with this schema
+        /// @param bytes serialized data
+        /// @return List with the elements, members not in the schema are default initialized
+        auto from_bytes( const ByteArray &bytes ) const -> List<T>
+        {
+            auto header = detail::read_header( bytes.data, bytes.length, type_id( ), true );
+            const auto *p = bytes.data + detail::serial_header_size;
+            const auto *end = p + header.payload;
+            if ( header.count > header.payload && ( sizeof...( M ) > 0 ) )
+                throw std::runtime_error( "truncated data" ); // every element needs at least one byte
+            auto ret = List<T>( );
+            ret.resize( header.count );
+            if ( header.layout == static_cast<uint8_t>( Layout::rows ) )
+                for ( auto &e : ret )
+                    std::apply( [ & ]( auto... m ) { ( read_field( p, end, e.*m ), ... ); }, members );
+            else if ( header.layout == static_cast<uint8_t>( Layout::columns ) )
+                std::apply(
+                    [ & ]( auto... m ) {
+                        ( [ & ] {
+                            for ( auto &e : ret )
+                                read_field( p, end, e.*m );
+                        }( ),
+                          ... );
+                    },
+                    members );
+            else
+                throw std::runtime_error( "data is not in the rows or columns layout" );
+            if ( p != end )
+                throw std::runtime_error( "payload size does not match the data" );
+            return ret;
+        }
+
+        /// @return fingerprint of the member types stored in the header
+        static constexpr auto type_id( ) -> uint32_t
+        {
+            // FNV-1a over the size of every member, strings are marked with 0xffffffff
+            uint32_t h = 2166136261u;
+            ( ( h = ( h ^ ( std::is_same_v<M, std::string> ? 0xffffffffu : static_cast<uint32_t>( sizeof( M ) ) ) ) *
+                    16777619u ),
+              ... );
+            return h;
+        }
+
+    private:
+        /*! \cond */
+        template <class V> static auto field_size( const V &v ) -> size_t
+        {
+            if constexpr ( std::is_same_v<V, std::string> )
+                return detail::varint_size( v.size( ) ) + v.size( );
+            else
+                return sizeof( V );
+        }
+
+        template <class V> static auto write_field( uint8_t *&p, const V &v ) -> void
+        {
+            if constexpr ( std::is_same_v<V, std::string> )
+            {
+                detail::write_varint( p, v.size( ) );
+                if ( !v.empty( ) )
+                    std::memcpy( p, v.data( ), v.size( ) );
+                p += v.size( );
+            }
+            else
+            {
+                std::memcpy( p, &v, sizeof( V ) );
+                p += sizeof( V );
+            }
+        }
+
+        template <class V> static auto read_field( const uint8_t *&p, const uint8_t *end, V &v ) -> void
+        {
+            if constexpr ( std::is_same_v<V, std::string> )
+            {
+                auto len = detail::read_varint( p, end );
+                if ( len > static_cast<uint64_t>( end - p ) )
+                    throw std::runtime_error( "truncated data" );
+                v.assign( reinterpret_cast<const char *>( p ), len );
+                p += len;
+            }
+            else
+            {
+                if ( static_cast<size_t>( end - p ) < sizeof( V ) )
+                    throw std::runtime_error( "truncated data" );
+                std::memcpy( &v, p, sizeof( V ) );
+                p += sizeof( V );
+            }
+        }
+
+        std::tuple<M T::*...> members;
+        /*! \endcond */
+    };
+
+    /// @brief creates a Schema from member pointers, e.g. schema( &Person::name, &Person::age )
+    /// @param ...members member pointers of the serialized members
+    /// @return Schema for T
+    template <class T, class... M> auto schema( M T::*...members ) -> Schema<T, M...>
+    {
+        return Schema<T, M...>( members... );
+    }
+} // namespace vrock::utils
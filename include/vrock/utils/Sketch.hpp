@@ -0,0 +1,470 @@
+#pragma once
+
+#include "List.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// @file
+/// Mergeable sketches for approximate analytics. Every sketch can be filled per chunk (e.g. with
+/// SegmentedList::parallel_for_each_chunk) and the partial sketches combined with merge, the error bounds hold for
+/// the merged sketch as well.
+
+namespace vrock::utils
+{
+    /*! \cond */
+    namespace detail
+    {
+        /// finalizer of splitmix64, spreads the bits of std::hash (which is the identity for integers)
+        inline auto mix64( uint64_t h ) -> uint64_t
+        {
+            h ^= h >> 30;
+            h *= 0xbf58476d1ce4e5b9ULL;
+            h ^= h >> 27;
+            h *= 0x94d049bb133111ebULL;
+            h ^= h >> 31;
+            return h;
+        }
+    } // namespace detail
+    /*! \endcond */
+
+    /// Estimates the number of distinct keys with a HyperLogLog sketch using 64 bit hashes and 2^precision one byte
+    /// registers. The relative standard error is 1.04 / sqrt( 2^precision ), about 0.8% for the default precision of
+    /// 14 (16 KiB), over the whole range of cardinalities.
+    ///
+    /// The estimate uses Ertl's improved estimator ("New cardinality estimation algorithms for HyperLogLog sketches",
+    /// 2017) instead of the empirical bias tables of HyperLogLog++, it is unbiased for small and large cardinalities
+    /// without them.
+    /// @tparam K type of the keys
+    template <class K> class HyperLogLog
+    {
+    public:
+        /// @param precision log2 of the number of registers, between 4 and 18
+        explicit HyperLogLog( uint8_t precision = 14 ) : p( precision )
+        {
+            if ( precision < 4 || precision > 18 )
+                throw std::invalid_argument( "precision has to be between 4 and 18" );
+            registers.assign( size_t( 1 ) << p, 0 );
+        }
+
+        /// @param key key to add
+        auto add( const K &key ) -> void
+        {
+            add_hash( detail::mix64( detail::key_hash<K>( )( key ) ) );
+        }
+        /// @param hash well mixed 64 bit hash of a key
+        auto add_hash( uint64_t hash ) -> void
+        {
+            auto index = hash >> ( 64 - p );
+            // rank of the first set bit of the remaining 64 - p bits, 65 - p if none is set
+            auto w = hash << p;
+            auto rank = static_cast<uint8_t>( w == 0 ? 65 - p : std::countl_zero( w ) + 1 );
+            registers[ index ] = std::max( registers[ index ], rank );
+        }
+        /// @brief adds all keys of other. both sketches must have the same precision
+        /// @param other sketch to merge
+        auto merge( const HyperLogLog &other ) -> void
+        {
+            if ( other.p != p )
+                throw std::invalid_argument( "sketches have different precisions" );
+            for ( size_t i = 0; i < registers.size( ); i++ )
+                registers[ i ] = std::max( registers[ i ], other.registers[ i ] );
+        }
+        /// @return estimated number of distinct keys
+        auto estimate( ) const -> double
+        {
+            const auto q = 64 - p;
+            auto histogram = std::vector<double>( q + 2, 0.0 );
+            for ( auto r : registers )
+                histogram[ r ]++;
+            const auto m = static_cast<double>( registers.size( ) );
+            auto z = m * tau( 1.0 - histogram[ q + 1 ] / m );
+            for ( int k = q; k >= 1; k-- )
+                z = 0.5 * ( z + histogram[ k ] );
+            z += m * sigma( histogram[ 0 ] / m );
+            return m * m / ( 2.0 * std::log( 2.0 ) ) / z;
+        }
+        /// @return relative standard error of the estimate
+        auto standard_error( ) const -> double
+        {
+            return 1.04 / std::sqrt( static_cast<double>( registers.size( ) ) );
+        }
+        /// @return log2 of the number of registers
+        auto precision( ) const -> uint8_t
+        {
+            return p;
+        }
+
+    private:
+        /*! \cond */
+        static auto sigma( double x ) -> double
+        {
+            if ( x == 1.0 )
+                return std::numeric_limits<double>::infinity( );
+            double y = 1.0, z = x, prev;
+            do
+            {
+                x *= x;
+                prev = z;
+                z += x * y;
+                y += y;
+            } while ( z != prev );
+            return z;
+        }
+
+        static auto tau( double x ) -> double
+        {
+            if ( x == 0.0 || x == 1.0 )
+                return 0.0;
+            double y = 1.0, z = 1.0 - x, prev;
+            do
+            {
+                x = std::sqrt( x );
+                prev = z;
+                y *= 0.5;
+                z -= ( 1.0 - x ) * ( 1.0 - x ) * y;
+            } while ( z != prev );
+            return z / 3.0;
+        }
+
+        uint8_t p;
+        std::vector<uint8_t> registers;
+        /*! \endcond */
+    };
+
+    /// Approximates quantiles of a stream of values with a KLL sketch (Karnin, Lang, Liberty 2016). The sketch keeps
+    /// O( k ) values in compactors of exponentially growing weight. The rank of a returned quantile differs from the
+    /// requested one by at most rank_error( ), about 1.3% for the default k of 200, with 99% confidence.
+    /// @tparam V type of the values, has to be ordered with less
+    template <class V> class QuantileSketch
+    {
+    public:
+        /// @param k accuracy parameter, at least 8. the error shrinks roughly with 1 / k
+        explicit QuantileSketch( size_t k = 200 ) : k( std::max<size_t>( 8, k ) ), levels( 1 )
+        {
+            update_capacity( );
+        }
+
+        /// @param v value to add
+        auto add( const V &v ) -> void
+        {
+            if ( n == 0 || less( v, lo ) )
+                lo = v;
+            if ( n == 0 || less( hi, v ) )
+                hi = v;
+            levels[ 0 ].push_back( v );
+            n++;
+            if ( ++retained > limit )
+                compress( );
+        }
+        /// @brief adds all values of other
+        /// @param other sketch to merge
+        auto merge( const QuantileSketch &other ) -> void
+        {
+            if ( other.n == 0 )
+                return;
+            if ( n == 0 || less( other.lo, lo ) )
+                lo = other.lo;
+            if ( n == 0 || less( hi, other.hi ) )
+                hi = other.hi;
+            if ( levels.size( ) < other.levels.size( ) )
+            {
+                levels.resize( other.levels.size( ) );
+                update_capacity( );
+            }
+            for ( size_t h = 0; h < other.levels.size( ); h++ )
+                levels[ h ].insert( levels[ h ].end( ), other.levels[ h ].begin( ), other.levels[ h ].end( ) );
+            n += other.n;
+            retained += other.retained;
+            while ( retained > limit )
+                compress( );
+        }
+        /// @param q rank between 0 and 1, 0.5 is the median
+        /// @return value whose rank is approximately q. throws an exception if the sketch is empty
+        auto quantile( double q ) const -> V
+        {
+            if ( n == 0 )
+                throw std::runtime_error( "sketch is empty" );
+            if ( q <= 0.0 )
+                return lo;
+            if ( q >= 1.0 )
+                return hi;
+            auto items = weighted( );
+            auto target = q * static_cast<double>( n );
+            uint64_t cumulative = 0;
+            for ( const auto &[ v, w ] : items )
+            {
+                cumulative += w;
+                if ( static_cast<double>( cumulative ) >= target )
+                    return v;
+            }
+            return hi;
+        }
+        /// @param v value to look up
+        /// @return approximate fraction of values smaller than or equal to v
+        auto rank( const V &v ) const -> double
+        {
+            if ( n == 0 )
+                throw std::runtime_error( "sketch is empty" );
+            uint64_t weight = 0;
+            for ( size_t h = 0; h < levels.size( ); h++ )
+                for ( const auto &e : levels[ h ] )
+                    if ( !less( v, e ) )
+                        weight += uint64_t( 1 ) << h;
+            return static_cast<double>( weight ) / static_cast<double>( n );
+        }
+        /// @return amount of added values
+        auto count( ) const -> uint64_t
+        {
+            return n;
+        }
+        /// @return amount of values kept in the sketch
+        auto retained_count( ) const -> size_t
+        {
+            return retained;
+        }
+        /// @return normalized rank error that holds with 99% confidence for a single quantile
+        auto rank_error( ) const -> double
+        {
+            // empirical fit of the KLL error published with the Apache DataSketches implementation
+            return 2.296 / std::pow( static_cast<double>( k ), 0.9723 );
+        }
+
+    private:
+        /*! \cond */
+        /// capacity of level h, the top level has k slots and every level below 2/3 of the one above
+        auto level_capacity( size_t h ) const -> size_t
+        {
+            auto depth = static_cast<double>( levels.size( ) - 1 - h );
+            return std::max<size_t>( 8, static_cast<size_t>( std::ceil( k * std::pow( 2.0 / 3.0, depth ) ) ) );
+        }
+
+        /// the sum of the level capacities only changes with the number of levels
+        auto update_capacity( ) -> void
+        {
+            limit = 0;
+            for ( size_t h = 0; h < levels.size( ); h++ )
+                limit += level_capacity( h );
+        }
+
+        /// halves the lowest full level by sorting it and promoting every other value to the next level
+        auto compress( ) -> void
+        {
+            for ( size_t h = 0; h < levels.size( ); h++ )
+            {
+                if ( levels[ h ].size( ) < level_capacity( h ) )
+                    continue;
+                if ( h + 1 == levels.size( ) )
+                {
+                    levels.emplace_back( );
+                    update_capacity( );
+                }
+                auto &level = levels[ h ];
+                std::sort( level.begin( ), level.end( ), []( const V &a, const V &b ) { return less( a, b ); } );
+                // an odd value stays on this level
+                auto leftover = level.size( ) % 2 == 1;
+                auto end = level.size( ) - ( leftover ? 1 : 0 );
+                for ( size_t i = next_bit( ); i < end; i += 2 )
+                    levels[ h + 1 ].push_back( level[ i ] );
+                retained -= end / 2;
+                if ( leftover )
+                    level.erase( level.begin( ), level.begin( ) + static_cast<std::ptrdiff_t>( end ) );
+                else
+                    level.clear( );
+                return;
+            }
+        }
+
+        auto next_bit( ) -> size_t
+        {
+            // xorshift64, deterministic so results are reproducible
+            rng ^= rng << 13;
+            rng ^= rng >> 7;
+            rng ^= rng << 17;
+            return rng & 1;
+        }
+
+        auto weighted( ) const -> std::vector<std::pair<V, uint64_t>>
+        {
+            auto items = std::vector<std::pair<V, uint64_t>>( );
+            items.reserve( retained );
+            for ( size_t h = 0; h < levels.size( ); h++ )
+                for ( const auto &e : levels[ h ] )
+                    items.emplace_back( e, uint64_t( 1 ) << h );
+            std::sort( items.begin( ), items.end( ),
+                       []( const auto &a, const auto &b ) { return less( a.first, b.first ); } );
+            return items;
+        }
+
+        size_t k;
+        std::vector<std::vector<V>> levels;
+        uint64_t n = 0;
+        size_t retained = 0;
+        size_t limit = 0;
+        V lo{ }, hi{ };
+        uint64_t rng = 0x9e3779b97f4a7c15ULL;
+        /*! \endcond */
+    };
+
+    /// key reported by SpaceSaving with its estimated frequency
+    template <class K> struct Frequent
+    {
+        K key;
+        /// estimated frequency, never smaller than the true one
+        uint64_t count;
+        /// count minus error is a lower bound of the true frequency
+        uint64_t error;
+    };
+
+    /// Finds the most frequent keys with the Space-Saving algorithm (Metwally et al. 2005) in O( capacity ) memory.
+    /// The count of every key overestimates the true frequency by at most error <= n / capacity, every key that occurs
+    /// more than n / capacity times is reported.
+    /// @tparam K type of the keys
+    template <class K> class SpaceSaving
+    {
+    public:
+        /// @param capacity amount of counters, at least 1
+        explicit SpaceSaving( size_t capacity = 1024 ) : cap( std::max<size_t>( 1, capacity ) )
+        {
+        }
+
+        /// @param key key to count
+        /// @param weight amount of occurrences
+        auto add( const K &key, uint64_t weight = 1 ) -> void
+        {
+            n += weight;
+            if ( auto it = positions.find( key ); it != positions.end( ) )
+            {
+                heap[ it->second ].count += weight;
+                sift_down( it->second );
+            }
+            else if ( heap.size( ) < cap )
+            {
+                heap.push_back( { key, weight, 0 } );
+                positions.emplace( key, heap.size( ) - 1 );
+                sift_up( heap.size( ) - 1 );
+            }
+            else
+            {
+                // replace the key with the smallest count, it might have occurred that often before
+                auto &min = heap.front( );
+                positions.erase( min.key );
+                min.error = min.count;
+                min.count += weight;
+                min.key = key;
+                positions.emplace( key, 0 );
+                sift_down( 0 );
+            }
+        }
+        /// @brief adds all counts of other (Agarwal et al., "Mergeable summaries"). keys missing in a full sketch are
+        /// assumed to have its smallest count
+        /// @param other sketch to merge
+        auto merge( const SpaceSaving &other ) -> void
+        {
+            auto floor_this = heap.size( ) < cap ? 0 : heap.front( ).count;
+            auto floor_other = other.heap.size( ) < other.cap ? 0 : other.heap.front( ).count;
+            auto merged = std::unordered_map<K, Frequent<K>, detail::key_hash<K>>( );
+            for ( const auto &e : heap )
+                merged.emplace( e.key, Frequent<K>{ e.key, e.count + floor_other, e.error + floor_other } );
+            for ( const auto &e : other.heap )
+            {
+                auto [ it, inserted ] = merged.try_emplace( e.key, Frequent<K>{ e.key, e.count + floor_this,
+                                                                                e.error + floor_this } );
+                if ( !inserted )
+                {
+                    it->second.count = it->second.count - floor_other + e.count;
+                    it->second.error = it->second.error - floor_other + e.error;
+                }
+            }
+            heap.clear( );
+            for ( auto &[ key, e ] : merged )
+                heap.push_back( std::move( e ) );
+            if ( heap.size( ) > cap )
+            {
+                std::nth_element( heap.begin( ), heap.begin( ) + static_cast<std::ptrdiff_t>( cap ), heap.end( ),
+                                  []( const auto &a, const auto &b ) { return a.count > b.count; } );
+                heap.resize( cap );
+            }
+            n += other.n;
+            rebuild( );
+        }
+        /// @param k amount of keys to return
+        /// @return up to k keys with the highest counts, most frequent first
+        auto top( size_t k ) const -> List<Frequent<K>>
+        {
+            auto ret = List<Frequent<K>>( heap.begin( ), heap.end( ) );
+            auto cmp = []( const auto &a, const auto &b ) { return a.count > b.count; };
+            k = std::min( k, ret.size( ) );
+            std::partial_sort( ret.begin( ), ret.begin( ) + static_cast<std::ptrdiff_t>( k ), ret.end( ), cmp );
+            ret.resize( k );
+            return ret;
+        }
+        /// @return amount of counted occurrences
+        auto count( ) const -> uint64_t
+        {
+            return n;
+        }
+        /// @return upper bound of the overestimation of every count, n / capacity
+        auto max_error( ) const -> uint64_t
+        {
+            return n / cap;
+        }
+
+    private:
+        /*! \cond */
+        // binary min heap on count with the position of every key, so increments are O( log capacity )
+        auto swap_entries( size_t a, size_t b ) -> void
+        {
+            std::swap( heap[ a ], heap[ b ] );
+            positions[ heap[ a ].key ] = a;
+            positions[ heap[ b ].key ] = b;
+        }
+
+        auto sift_up( size_t i ) -> void
+        {
+            while ( i > 0 && heap[ i ].count < heap[ ( i - 1 ) / 2 ].count )
+            {
+                swap_entries( i, ( i - 1 ) / 2 );
+                i = ( i - 1 ) / 2;
+            }
+        }
+
+        auto sift_down( size_t i ) -> void
+        {
+            while ( true )
+            {
+                auto smallest = i;
+                for ( auto c : { 2 * i + 1, 2 * i + 2 } )
+                    if ( c < heap.size( ) && heap[ c ].count < heap[ smallest ].count )
+                        smallest = c;
+                if ( smallest == i )
+                    return;
+                swap_entries( i, smallest );
+                i = smallest;
+            }
+        }
+
+        auto rebuild( ) -> void
+        {
+            std::make_heap( heap.begin( ), heap.end( ),
+                            []( const auto &a, const auto &b ) { return a.count > b.count; } );
+            positions.clear( );
+            for ( size_t i = 0; i < heap.size( ); i++ )
+                positions.emplace( heap[ i ].key, i );
+        }
+
+        size_t cap;
+        uint64_t n = 0;
+        std::vector<Frequent<K>> heap;
+        std::unordered_map<K, size_t, detail::key_hash<K>> positions;
+        /*! \endcond */
+    };
+} // namespace vrock::utils
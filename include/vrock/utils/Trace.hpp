@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "vrockutils_conf.h"
+
+/// @file
+/// Opt-in tracing of List operators. The operators are only instrumented if VROCKUTILS_TRACE is defined (meson option
+/// trace), otherwise the trace macros expand to nothing. The sinks and emit can be used either way.
+
+namespace vrock::utils::trace
+{
+    /// one traced operator invocation
+    struct Event
+    {
+        /// operator name, e.g. "List::where"
+        const char *op = "";
+        /// amount of input elements
+        size_t input = 0;
+        /// amount of output elements (or groups)
+        size_t output = 0;
+        /// start time in nanoseconds of std::chrono::steady_clock
+        int64_t start_ns = 0;
+        /// wall time in nanoseconds
+        int64_t duration_ns = 0;
+        /// bytes allocated by the operator. measured with the allocation counter if one is set, otherwise the size of
+        /// the result
+        size_t bytes = 0;
+        /// id of the calling thread
+        uint64_t thread = 0;
+    };
+
+    /// receives the traced events. record may be called from multiple threads at the same time
+    class VROCKUTILS_API Sink
+    {
+    public:
+        virtual ~Sink( ) = default;
+        /// called once per traced operator invocation
+        virtual auto record( const Event &e ) -> void = 0;
+        /// writes buffered events, if the sink buffers them
+        virtual auto flush( ) -> void
+        {
+        }
+    };
+
+    /// calls a function for every event
+    class VROCKUTILS_API CallbackSink : public Sink
+    {
+    public:
+        explicit CallbackSink( std::function<void( const Event & )> callback );
+        auto record( const Event &e ) -> void override;
+
+    private:
+        std::mutex mutex;
+        std::function<void( const Event & )> callback;
+    };
+
+    /// keeps the last capacity events in memory
+    class VROCKUTILS_API RingSink : public Sink
+    {
+    public:
+        explicit RingSink( size_t capacity = 4096 );
+        auto record( const Event &e ) -> void override;
+
+        /// @return the stored events, oldest first
+        auto events( ) const -> std::vector<Event>;
+        /// @return amount of events that were overwritten
+        auto dropped( ) const -> size_t;
+        /// removes all stored events
+        auto clear( ) -> void;
+
+    private:
+        mutable std::mutex mutex;
+        std::vector<Event> ring;
+        size_t next = 0;
+        size_t total = 0;
+    };
+
+    /// writes the events in the Chrome trace event format, viewable in chrome://tracing or Perfetto. the file is
+    /// written on flush and when the sink is destroyed
+    class VROCKUTILS_API ChromeTraceSink : public Sink
+    {
+    public:
+        explicit ChromeTraceSink( std::string path );
+        ~ChromeTraceSink( ) override;
+        auto record( const Event &e ) -> void override;
+        auto flush( ) -> void override;
+
+    private:
+        std::mutex mutex;
+        std::string path;
+        std::vector<Event> events;
+    };
+
+    /// @brief sets the sink that receives all events, nullptr disables tracing
+    VROCKUTILS_API auto set_sink( std::shared_ptr<Sink> sink ) -> void;
+    /// @return the current sink or nullptr
+    VROCKUTILS_API auto get_sink( ) -> std::shared_ptr<Sink>;
+    /// @return true if a sink is set
+    VROCKUTILS_API auto enabled( ) -> bool;
+    /// @brief passes an event to the current sink
+    VROCKUTILS_API auto emit( const Event &e ) -> void;
+    /// @brief sets a function returning the amount of bytes allocated so far, e.g. from an operator new override.
+    /// events then report the bytes allocated during the operator instead of the size of the result
+    VROCKUTILS_API auto set_allocation_counter( size_t ( *counter )( ) ) -> void;
+    /// @return the bytes allocated so far or 0 if no allocation counter is set
+    VROCKUTILS_API auto allocated_bytes( ) -> size_t;
+    /// @return true if an allocation counter is set
+    VROCKUTILS_API auto has_allocation_counter( ) -> bool;
+    /// @return current time of std::chrono::steady_clock in nanoseconds
+    VROCKUTILS_API auto now_ns( ) -> int64_t;
+    /// @return id of the calling thread
+    VROCKUTILS_API auto thread_id( ) -> uint64_t;
+
+    /// records an event for the lifetime of the scope. does nothing if no sink is set
+    class Scope
+    {
+    public:
+        Scope( const char *op, size_t input ) : active( enabled( ) )
+        {
+            if ( !active )
+                return;
+            event.op = op;
+            event.input = input;
+            event.thread = thread_id( );
+            if ( has_allocation_counter( ) )
+                bytes_before = allocated_bytes( );
+            event.start_ns = now_ns( );
+        }
+        Scope( const Scope & ) = delete;
+        auto operator=( const Scope & ) -> Scope & = delete;
+        ~Scope( )
+        {
+            if ( !active )
+                return;
+            event.duration_ns = now_ns( ) - event.start_ns;
+            if ( has_allocation_counter( ) )
+                event.bytes = allocated_bytes( ) - bytes_before;
+            emit( event );
+        }
+
+        /// sets output cardinality and result size from a container
+        template <class C> auto result( const C &c ) -> void
+        {
+            if ( !active )
+                return;
+            event.output = c.size( );
+            if constexpr ( requires { c.capacity( ); } )
+                event.bytes = c.capacity( ) * sizeof( typename C::value_type );
+            else
+                event.bytes = c.size( ) * sizeof( typename C::value_type );
+        }
+
+    private:
+        bool active;
+        size_t bytes_before = 0;
+        Event event;
+    };
+} // namespace vrock::utils::trace
+
+#ifdef VROCKUTILS_TRACE
+    /// traces the enclosing operator
+    #define VROCKUTILS_TRACE_OP( op, input ) ::vrock::utils::trace::Scope vrockutils_trace_scope_( op, input )
+    /// reports the result of the operator traced with VROCKUTILS_TRACE_OP
+    #define VROCKUTILS_TRACE_RESULT( container ) vrockutils_trace_scope_.result( container )
+#else
+    #define VROCKUTILS_TRACE_OP( op, input )
+    #define VROCKUTILS_TRACE_RESULT( container )
+#endif
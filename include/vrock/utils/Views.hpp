@@ -0,0 +1,450 @@
+#pragma once
+
+#include "List.hpp"
+#include "ObservableList.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace vrock::utils
+{
+    /// Number of elements per key, maintained on every change of the observed list.
+    /// @tparam T type of the list elements
+    /// @tparam K key selector (callable or member pointer)
+    template <class T, class K> class CountView : public ListObserver<T>
+    {
+    public:
+        using key_type = detail::key_t<K, T>;
+
+        /// @param list list to observe
+        /// @param key key selector
+        CountView( ObservableList<T> &list, K key ) : key( std::move( key ) )
+        {
+            list.subscribe( *this );
+        }
+
+    public:
+        /// @return amount of elements with key k
+        auto count( const key_type &k ) const -> size_t
+        {
+            auto it = counts.find( k );
+            return it == counts.end( ) ? 0 : it->second;
+        }
+        /// @return hash map from key to the amount of elements with that key
+        auto groups( ) const -> const std::unordered_map<key_type, size_t, detail::key_hash<key_type>> &
+        {
+            return counts;
+        }
+
+        auto on_insert( const T &e, size_t ) -> void override
+        {
+            ++counts[ std::invoke( key, e ) ];
+        }
+        auto on_erase( const T &e, size_t ) -> void override
+        {
+            auto it = counts.find( std::invoke( key, e ) );
+            if ( it != counts.end( ) && --it->second == 0 )
+                counts.erase( it );
+        }
+        auto on_clear( const List<T> & ) -> void override
+        {
+            counts.clear( );
+        }
+
+    private:
+        K key;
+        std::unordered_map<key_type, size_t, detail::key_hash<key_type>> counts;
+    };
+
+    /// Sum and number of values per key, maintained on every change of the observed list.
+    /// @tparam T type of the list elements
+    /// @tparam K key selector (callable or member pointer)
+    /// @tparam V value selector (callable or member pointer)
+    template <class T, class K, class V> class SumView : public ListObserver<T>
+    {
+    public:
+        using key_type = detail::key_t<K, T>;
+        using value_type = detail::key_t<V, T>;
+
+        /// aggregated values of one key
+        struct group
+        {
+            value_type sum{ };
+            size_t count = 0;
+        };
+
+        /// @param list list to observe
+        /// @param key key selector
+        /// @param value value selector
+        SumView( ObservableList<T> &list, K key, V value ) : key( std::move( key ) ), value( std::move( value ) )
+        {
+            list.subscribe( *this );
+        }
+
+    public:
+        /// @return sum of the values with key k
+        auto sum( const key_type &k ) const -> value_type
+        {
+            auto it = sums.find( k );
+            return it == sums.end( ) ? value_type( ) : it->second.sum;
+        }
+        /// @return hash map from key to the sum and count of that key
+        auto groups( ) const -> const std::unordered_map<key_type, group, detail::key_hash<key_type>> &
+        {
+            return sums;
+        }
+
+        auto on_insert( const T &e, size_t ) -> void override
+        {
+            auto &g = sums[ std::invoke( key, e ) ];
+            g.sum += std::invoke( value, e );
+            g.count++;
+        }
+        auto on_erase( const T &e, size_t ) -> void override
+        {
+            auto it = sums.find( std::invoke( key, e ) );
+            if ( it == sums.end( ) )
+                return;
+            if ( --it->second.count == 0 )
+                sums.erase( it );
+            else
+                it->second.sum -= std::invoke( value, e );
+        }
+        auto on_clear( const List<T> & ) -> void override
+        {
+            sums.clear( );
+        }
+
+    private:
+        K key;
+        V value;
+        std::unordered_map<key_type, group, detail::key_hash<key_type>> sums;
+    };
+
+    /// Smallest or largest value per key, maintained on every change of the observed list. Every key keeps an ordered
+    /// multiset of its values, so erasing the current extreme is O(log n).
+    /// @tparam T type of the list elements
+    /// @tparam K key selector (callable or member pointer)
+    /// @tparam V value selector (callable or member pointer)
+    /// @tparam Max true for the largest value
+    template <class T, class K, class V, bool Max> class ExtremeView : public ListObserver<T>
+    {
+    public:
+        using key_type = detail::key_t<K, T>;
+        using value_type = detail::key_t<V, T>;
+
+        /// @param list list to observe
+        /// @param key key selector
+        /// @param value value selector
+        ExtremeView( ObservableList<T> &list, K key, V value ) : key( std::move( key ) ), value( std::move( value ) )
+        {
+            list.subscribe( *this );
+        }
+
+    public:
+        /// @return the extreme value of key k. throws an exception if there is no element with that key
+        auto get( const key_type &k ) const -> const value_type &
+        {
+            auto it = values.find( k );
+            if ( it == values.end( ) )
+                throw std::out_of_range( "no element with this key" );
+            return Max ? it->second.rbegin( )->first : it->second.begin( )->first;
+        }
+        /// @return true if there is an element with key k
+        auto contains( const key_type &k ) const -> bool
+        {
+            return values.find( k ) != values.end( );
+        }
+
+        auto on_insert( const T &e, size_t ) -> void override
+        {
+            ++values[ std::invoke( key, e ) ][ std::invoke( value, e ) ];
+        }
+        auto on_erase( const T &e, size_t ) -> void override
+        {
+            auto it = values.find( std::invoke( key, e ) );
+            if ( it == values.end( ) )
+                return;
+            auto v = it->second.find( std::invoke( value, e ) );
+            if ( v != it->second.end( ) && --v->second == 0 )
+                it->second.erase( v );
+            if ( it->second.empty( ) )
+                values.erase( it );
+        }
+        auto on_clear( const List<T> & ) -> void override
+        {
+            values.clear( );
+        }
+
+    private:
+        /*! \cond */
+        struct value_less
+        {
+            auto operator( )( const value_type &a, const value_type &b ) const -> bool
+            {
+                return less( a, b );
+            }
+        };
+        /*! \endcond */
+
+        K key;
+        V value;
+        std::unordered_map<key_type, std::map<value_type, size_t, value_less>, detail::key_hash<key_type>> values;
+    };
+
+    /// Smallest value per key, see ExtremeView
+    template <class T, class K, class V> class MinView : public ExtremeView<T, K, V, false>
+    {
+    public:
+        MinView( ObservableList<T> &list, K key, V value )
+            : ExtremeView<T, K, V, false>( list, std::move( key ), std::move( value ) )
+        {
+        }
+    };
+
+    /// Largest value per key, see ExtremeView
+    template <class T, class K, class V> class MaxView : public ExtremeView<T, K, V, true>
+    {
+    public:
+        MaxView( ObservableList<T> &list, K key, V value )
+            : ExtremeView<T, K, V, true>( list, std::move( key ), std::move( value ) )
+        {
+        }
+    };
+
+    /// Number of distinct keys, maintained on every change of the observed list.
+    /// @tparam T type of the list elements
+    /// @tparam K key selector (callable or member pointer)
+    template <class T, class K> class DistinctCountView : public ListObserver<T>
+    {
+    public:
+        using key_type = detail::key_t<K, T>;
+
+        /// @param list list to observe
+        /// @param key key selector
+        DistinctCountView( ObservableList<T> &list, K key ) : key( std::move( key ) )
+        {
+            list.subscribe( *this );
+        }
+
+    public:
+        /// @return amount of distinct keys
+        auto count( ) const -> size_t
+        {
+            return refs.size( );
+        }
+        /// @return true if an element with key k exists
+        auto contains( const key_type &k ) const -> bool
+        {
+            return refs.find( k ) != refs.end( );
+        }
+
+        auto on_insert( const T &e, size_t ) -> void override
+        {
+            ++refs[ std::invoke( key, e ) ];
+        }
+        auto on_erase( const T &e, size_t ) -> void override
+        {
+            auto it = refs.find( std::invoke( key, e ) );
+            if ( it != refs.end( ) && --it->second == 0 )
+                refs.erase( it );
+        }
+        auto on_clear( const List<T> & ) -> void override
+        {
+            refs.clear( );
+        }
+
+    private:
+        K key;
+        std::unordered_map<key_type, size_t, detail::key_hash<key_type>> refs;
+    };
+
+    /// Running total and count over all elements, maintained on every change of the observed list.
+    /// @tparam T type of the list elements
+    /// @tparam V value selector (callable or member pointer)
+    template <class T, class V> class RunningTotalView : public ListObserver<T>
+    {
+    public:
+        using value_type = detail::key_t<V, T>;
+
+        /// @param list list to observe
+        /// @param value value selector
+        RunningTotalView( ObservableList<T> &list, V value ) : value( std::move( value ) )
+        {
+            list.subscribe( *this );
+        }
+
+    public:
+        /// @return sum of all values
+        auto total( ) const -> value_type
+        {
+            return sum;
+        }
+        /// @return amount of elements
+        auto count( ) const -> size_t
+        {
+            return n;
+        }
+        /// @return mean of all values. throws an exception if the list is empty
+        auto average( ) const -> double
+        {
+            if ( n == 0 )
+                throw std::runtime_error( "List is empty" );
+            return static_cast<double>( sum ) / static_cast<double>( n );
+        }
+
+        auto on_insert( const T &e, size_t ) -> void override
+        {
+            sum += std::invoke( value, e );
+            n++;
+        }
+        auto on_erase( const T &e, size_t ) -> void override
+        {
+            sum -= std::invoke( value, e );
+            n--;
+        }
+        auto on_clear( const List<T> & ) -> void override
+        {
+            sum = value_type( );
+            n = 0;
+        }
+
+    private:
+        V value;
+        value_type sum{ };
+        size_t n = 0;
+    };
+
+    /// User defined aggregate per key, maintained on every change of the observed list.
+    ///
+    /// Inserts fold the element into its group. Erases use the inverse function if one is given, otherwise the group
+    /// of the erased element is recomputed from the observed list.
+    /// @tparam T type of the list elements
+    /// @tparam K key selector (callable or member pointer)
+    /// @tparam A type of the aggregated value
+    /// @tparam F aggregate function, takes the element and the value of the group so far and returns the new value
+    /// @tparam G inverse of F or std::nullptr_t
+    template <class T, class K, class A, class F, class G = std::nullptr_t> class AggregateView : public ListObserver<T>
+    {
+    public:
+        using key_type = detail::key_t<K, T>;
+
+        /// @param list list to observe
+        /// @param key key selector
+        /// @param init start value of every group
+        /// @param fold aggregate function
+        /// @param unfold inverse of the aggregate function, removes an element from the value of its group
+        AggregateView( ObservableList<T> &list, K key, A init, F fold, G unfold = nullptr )
+            : key( std::move( key ) ), init( std::move( init ) ), fold( std::move( fold ) ),
+              unfold( std::move( unfold ) )
+        {
+            list.subscribe( *this );
+        }
+
+    public:
+        /// @return aggregated value of key k, the start value if no element has that key
+        auto get( const key_type &k ) const -> A
+        {
+            auto it = values.find( k );
+            return it == values.end( ) ? init : it->second.value;
+        }
+
+        auto on_insert( const T &e, size_t ) -> void override
+        {
+            auto &g = values.try_emplace( std::invoke( key, e ), group{ init, 0 } ).first->second;
+            g.value = fold( e, std::move( g.value ) );
+            g.count++;
+        }
+        auto on_erase( const T &e, size_t pos ) -> void override
+        {
+            auto k = key_type( std::invoke( key, e ) );
+            auto it = values.find( k );
+            if ( it == values.end( ) )
+                return;
+            if ( --it->second.count == 0 )
+            {
+                values.erase( it );
+                return;
+            }
+            if constexpr ( !std::is_same_v<G, std::nullptr_t> )
+                it->second.value = unfold( e, std::move( it->second.value ) );
+            else
+            {
+                // not invertible, recompute the group without the element that is about to be removed
+                const auto &elements = this->observed( )->list( );
+                auto value = init;
+                for ( size_t i = 0; i < elements.size( ); i++ )
+                    if ( i != pos && key_type( std::invoke( key, elements[ i ] ) ) == k )
+                        value = fold( elements[ i ], std::move( value ) );
+                it->second.value = std::move( value );
+            }
+        }
+        auto on_erase_batch( const List<T> &elements, const std::vector<size_t> &positions ) -> void override
+        {
+            if constexpr ( !std::is_same_v<G, std::nullptr_t> )
+                ListObserver<T>::on_erase_batch( elements, positions );
+            else
+            {
+                // not invertible, recompute every affected group once without any of the removed elements
+                auto affected = std::unordered_set<key_type, detail::key_hash<key_type>>( );
+                for ( auto pos : positions )
+                {
+                    auto k = key_type( std::invoke( key, elements[ pos ] ) );
+                    auto it = values.find( k );
+                    if ( it == values.end( ) )
+                        continue;
+                    if ( --it->second.count == 0 )
+                    {
+                        values.erase( it );
+                        affected.erase( k );
+                    }
+                    else
+                        affected.insert( std::move( k ) );
+                }
+                for ( const auto &k : affected )
+                    values.find( k )->second.value = init;
+                size_t next = 0;
+                for ( size_t i = 0; i < elements.size( ) && !affected.empty( ); i++ )
+                {
+                    if ( next < positions.size( ) && positions[ next ] == i )
+                    {
+                        next++;
+                        continue;
+                    }
+                    auto k = key_type( std::invoke( key, elements[ i ] ) );
+                    if ( affected.count( k ) )
+                    {
+                        auto &g = values.find( k )->second;
+                        g.value = fold( elements[ i ], std::move( g.value ) );
+                    }
+                }
+            }
+        }
+        auto on_clear( const List<T> & ) -> void override
+        {
+            values.clear( );
+        }
+
+    private:
+        /*! \cond */
+        struct group
+        {
+            A value;
+            size_t count;
+        };
+        /*! \endcond */
+
+        K key;
+        A init;
+        F fold;
+        G unfold;
+        std::unordered_map<key_type, group, detail::key_hash<key_type>> values;
+    };
+} // namespace vrock::utils
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "List.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace vrock::utils
+{
+    /// Windows over a contiguous range of elements without copying them. Window i starts at element i * step and
+    /// contains up to width elements. Created by List::chunk and List::window, it must not outlive the List.
+    /// @tparam T type of the elements
+    template <class T> class WindowView
+    {
+    public:
+        /// input iterator over the windows
+        class iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = std::span<const T>;
+            using difference_type = std::ptrdiff_t;
+
+            iterator( const WindowView *view, size_t i ) : view( view ), i( i )
+            {
+            }
+            auto operator*( ) const -> std::span<const T>
+            {
+                return ( *view )[ i ];
+            }
+            auto operator++( ) -> iterator &
+            {
+                ++i;
+                return *this;
+            }
+            auto operator++( int ) -> iterator
+            {
+                auto ret = *this;
+                ++i;
+                return ret;
+            }
+            auto operator==( const iterator &o ) const -> bool
+            {
+                return i == o.i;
+            }
+
+        private:
+            const WindowView *view;
+            size_t i;
+        };
+
+        /// @param data elements
+        /// @param width amount of elements per window
+        /// @param step distance between the starts of two windows
+        /// @param partial if true the last windows may contain less than width elements
+        WindowView( std::span<const T> data, size_t width, size_t step, bool partial )
+            : data( data ), width( width ), step( step ), partial( partial )
+        {
+            if ( width == 0 || step == 0 )
+                throw std::invalid_argument( "window width and step have to be greater than zero" );
+        }
+
+        /// @return amount of windows
+        auto size( ) const -> size_t
+        {
+            if ( partial )
+                return ( data.size( ) + step - 1 ) / step;
+            return data.size( ) < width ? 0 : ( data.size( ) - width ) / step + 1;
+        }
+        /// @return true if there are no windows
+        auto empty( ) const -> bool
+        {
+            return size( ) == 0;
+        }
+        /// @param i index of the window
+        /// @return elements of the window
+        auto operator[]( size_t i ) const -> std::span<const T>
+        {
+            auto start = i * step;
+            return data.subspan( start, std::min( width, data.size( ) - start ) );
+        }
+        /// @param i index of the window
+        /// @return elements of the window. throws an exception if i is out of bounds
+        auto at( size_t i ) const -> std::span<const T>
+        {
+            if ( i >= size( ) )
+                throw std::out_of_range( "out of bounds" );
+            return ( *this )[ i ];
+        }
+        auto begin( ) const -> iterator
+        {
+            return iterator( this, 0 );
+        }
+        auto end( ) const -> iterator
+        {
+            return iterator( this, size( ) );
+        }
+
+        /// @param exp expression that takes the elements of a window (std::span<const T>)
+        /// @return List with the result of exp for every window
+        template <class F>
+        auto select( F exp ) const -> List<std::decay_t<std::invoke_result_t<F &, std::span<const T>>>>
+        {
+            auto ret = List<std::decay_t<std::invoke_result_t<F &, std::span<const T>>>>( );
+            ret.reserve( size( ) );
+            for ( size_t i = 0; i < size( ); i++ )
+                ret.push_back( exp( ( *this )[ i ] ) );
+            return ret;
+        }
+        /// @return copies of all windows
+        auto to_list( ) const -> List<List<T>>
+        {
+            return select( []( std::span<const T> w ) { return List<T>( w.begin( ), w.end( ) ); } );
+        }
+
+    private:
+        std::span<const T> data;
+        size_t width;
+        size_t step;
+        bool partial;
+    };
+
+    /// elements of a time based window, [start, end) on the time key
+    /// @tparam T type of the elements
+    /// @tparam Time type of the time key
+    template <class T, class Time> struct TimeWindow
+    {
+        /// inclusive start of the window
+        Time start;
+        /// exclusive end of the window
+        Time end;
+        /// elements whose time is in [start, end), a view into the List
+        std::span<const T> elements;
+    };
+} // namespace vrock::utils
@@ -44,7 +44,7 @@ namespace vrock::utils
     {
         auto *n = (uint8_t *)std::malloc( sizeof( uint8_t ) * ( length + data->length ) );
         std::memcpy( n, this->data, length );
-        std::memcpy( n + length, data->data, length );
+        std::memcpy( n + length, data->data, data->length );
         std::free( this->data );
         length = length + data->length;
         this->data = n;
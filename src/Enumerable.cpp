@@ -0,0 +1,140 @@
+#include "vrock/utils/Enumerable.hpp"
+
+#include <cstring>
+#include <deque>
+
+namespace vrock::utils
+{
+    namespace
+    {
+        auto read_chunks_impl( std::ifstream file, size_t chunk_size ) -> Enumerable<std::shared_ptr<ByteArray>>
+        {
+            while ( file )
+            {
+                auto chunk = std::make_shared<ByteArray>( chunk_size );
+                file.read( reinterpret_cast<char *>( chunk->data ), static_cast<std::streamsize>( chunk_size ) );
+                auto read = static_cast<size_t>( file.gcount( ) );
+                if ( read == 0 )
+                    break;
+                chunk->length = read; // the last chunk keeps its allocation but only exposes the bytes read
+                auto batch = List<std::shared_ptr<ByteArray>>( );
+                batch.push_back( std::move( chunk ) );
+                co_yield std::move( batch );
+            }
+        }
+
+        auto split_impl( Enumerable<std::shared_ptr<ByteArray>> chunks, char delimiter, size_t batch_size )
+            -> Enumerable<std::string>
+        {
+            auto pending = std::string( );
+            auto out = List<std::string>( );
+            while ( auto *batch = chunks.next_batch( ) )
+            {
+                for ( const auto &chunk : *batch )
+                {
+                    const auto *data = reinterpret_cast<const char *>( chunk->data );
+                    size_t start = 0;
+                    while ( start < chunk->length )
+                    {
+                        const auto *hit = static_cast<const char *>(
+                            std::memchr( data + start, delimiter, chunk->length - start ) );
+                        if ( hit == nullptr )
+                        {
+                            pending.append( data + start, chunk->length - start );
+                            break;
+                        }
+                        auto pos = static_cast<size_t>( hit - data );
+                        pending.append( data + start, pos - start );
+                        out.push_back( std::move( pending ) );
+                        pending = std::string( );
+                        start = pos + 1;
+                        if ( out.size( ) >= batch_size )
+                        {
+                            co_yield std::move( out );
+                            out = List<std::string>( );
+                        }
+                    }
+                }
+            }
+            if ( !pending.empty( ) )
+                out.push_back( std::move( pending ) );
+            if ( !out.empty( ) )
+                co_yield std::move( out );
+        }
+
+        /// single thread resuming the consumers of AsyncEnumerables in the order they became ready
+        class executor
+        {
+        public:
+            executor( ) : worker( [ this ] { run( ); } )
+            {
+            }
+            ~executor( )
+            {
+                {
+                    auto lock = std::lock_guard( mutex );
+                    stop = true;
+                }
+                wake.notify_all( );
+                worker.join( );
+            }
+
+            auto post( std::coroutine_handle<> h ) -> void
+            {
+                {
+                    auto lock = std::lock_guard( mutex );
+                    queue.push_back( h );
+                }
+                wake.notify_one( );
+            }
+
+        private:
+            auto run( ) -> void
+            {
+                while ( true )
+                {
+                    auto lock = std::unique_lock( mutex );
+                    wake.wait( lock, [ this ] { return stop || !queue.empty( ); } );
+                    if ( queue.empty( ) )
+                        return;
+                    auto h = queue.front( );
+                    queue.pop_front( );
+                    lock.unlock( );
+                    h.resume( );
+                }
+            }
+
+            std::mutex mutex;
+            std::condition_variable wake;
+            std::deque<std::coroutine_handle<>> queue;
+            bool stop = false;
+            std::thread worker;
+        };
+    } // namespace
+
+    auto detail::resume_on_executor( std::coroutine_handle<> h ) -> void
+    {
+        static auto instance = executor( );
+        instance.post( h );
+    }
+
+    auto read_chunks( std::string path, size_t chunk_size ) -> Enumerable<std::shared_ptr<ByteArray>>
+    {
+        if ( chunk_size == 0 )
+            throw std::invalid_argument( "chunk size has to be greater than zero" );
+        auto file = std::ifstream( path, std::ios::binary );
+        if ( !file )
+            throw std::runtime_error( "failed to open file: " + path );
+        return Enumerable<std::shared_ptr<ByteArray>>::with_batch_size(
+            read_chunks_impl( std::move( file ), chunk_size ), 1 );
+    }
+
+    auto split( Enumerable<std::shared_ptr<ByteArray>> chunks, char delimiter, size_t batch_size )
+        -> Enumerable<std::string>
+    {
+        if ( batch_size == 0 )
+            batch_size = 1;
+        return Enumerable<std::string>::with_batch_size( split_impl( std::move( chunks ), delimiter, batch_size ),
+                                                         batch_size );
+    }
+} // namespace vrock::utils
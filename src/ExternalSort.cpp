@@ -0,0 +1,101 @@
+#include "vrock/utils/ExternalSort.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <random>
+
+namespace vrock::utils::detail
+{
+    namespace
+    {
+        auto unique_name( ) -> std::string
+        {
+            static std::atomic<uint64_t> counter = 0;
+            static const uint64_t seed = std::random_device( )( );
+            return "vrockutils-sort-" + std::to_string( seed ) + "-" + std::to_string( counter++ ) + ".run";
+        }
+    } // namespace
+
+    TempFile::TempFile( const std::string &directory )
+    {
+        auto dir = directory.empty( ) ? std::filesystem::temp_directory_path( ) : std::filesystem::path( directory );
+        file = ( dir / unique_name( ) ).string( );
+    }
+
+    TempFile::TempFile( TempFile &&o ) noexcept : file( std::move( o.file ) )
+    {
+        o.file.clear( );
+    }
+
+    auto TempFile::operator=( TempFile &&o ) noexcept -> TempFile &
+    {
+        if ( this != &o )
+        {
+            if ( !file.empty( ) )
+            {
+                auto ec = std::error_code( );
+                std::filesystem::remove( file, ec );
+            }
+            file = std::move( o.file );
+            o.file.clear( );
+        }
+        return *this;
+    }
+
+    TempFile::~TempFile( )
+    {
+        if ( !file.empty( ) )
+        {
+            auto ec = std::error_code( );
+            std::filesystem::remove( file, ec );
+        }
+    }
+
+    auto TempFile::path( ) const -> const std::string &
+    {
+        return file;
+    }
+
+    BlockWriter::BlockWriter( const std::string &path ) : out( path, std::ios::binary | std::ios::trunc ), path( path )
+    {
+        if ( !out )
+            throw std::runtime_error( "failed to open file: " + path );
+    }
+
+    auto BlockWriter::write( const ByteArray &block ) -> void
+    {
+        auto length = static_cast<uint64_t>( block.length );
+        out.write( reinterpret_cast<const char *>( &length ), sizeof( length ) );
+        out.write( reinterpret_cast<const char *>( block.data ), static_cast<std::streamsize>( block.length ) );
+        if ( !out )
+            throw std::runtime_error( "failed to write file: " + path );
+    }
+
+    auto BlockWriter::close( ) -> void
+    {
+        out.close( );
+        if ( !out )
+            throw std::runtime_error( "failed to write file: " + path );
+    }
+
+    BlockReader::BlockReader( const std::string &path ) : in( path, std::ios::binary )
+    {
+        if ( !in )
+            throw std::runtime_error( "failed to open file: " + path );
+    }
+
+    auto BlockReader::next( ) -> std::shared_ptr<ByteArray>
+    {
+        uint64_t length = 0;
+        in.read( reinterpret_cast<char *>( &length ), sizeof( length ) );
+        if ( in.gcount( ) == 0 )
+            return nullptr;
+        if ( in.gcount( ) != sizeof( length ) )
+            throw std::runtime_error( "truncated block" );
+        auto block = std::make_shared<ByteArray>( static_cast<size_t>( length ) );
+        in.read( reinterpret_cast<char *>( block->data ), static_cast<std::streamsize>( length ) );
+        if ( static_cast<uint64_t>( in.gcount( ) ) != length )
+            throw std::runtime_error( "truncated block" );
+        return block;
+    }
+} // namespace vrock::utils::detail
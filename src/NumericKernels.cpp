@@ -0,0 +1,572 @@
+#include "vrock/utils/NumericKernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+    #define VROCKUTILS_AVX2_KERNELS 1
+    #include <immintrin.h>
+    #define VROCKUTILS_AVX2 __attribute__( ( target( "avx2,popcnt" ) ) )
+#endif
+
+namespace vrock::utils::kernels
+{
+    namespace
+    {
+        std::atomic<bool> use_simd{ true };
+
+        /// ordering of less(): NaN compares greater than every number
+        template <class T> auto lt( T a, T b ) -> bool
+        {
+            if constexpr ( std::is_floating_point_v<T> )
+                if ( std::isnan( b ) )
+                    return !std::isnan( a );
+            return a < b;
+        }
+
+        template <class T> auto is_nan( T v ) -> bool
+        {
+            if constexpr ( std::is_floating_point_v<T> )
+                return std::isnan( v );
+            else
+                return false;
+        }
+
+        template <class T> auto matches( T v, Compare op, T a, T b ) -> bool
+        {
+            switch ( op )
+            {
+            case Compare::less:
+                return lt( v, a );
+            case Compare::greater:
+                return lt( a, v );
+            case Compare::equal:
+                return !lt( v, a ) && !lt( a, v );
+            case Compare::between:
+                return !lt( v, a ) && !lt( b, v );
+            }
+            return false;
+        }
+
+        // scalar kernels. the sums use independent accumulators so the compiler can vectorize them for the baseline
+        // instruction set (SSE2 on x86-64)
+
+        template <class S, class T> auto sum_scalar( const T *data, size_t n ) -> S
+        {
+            // integer sums wrap instead of overflowing
+            using A = typename std::conditional_t<std::is_integral_v<S>, std::make_unsigned<S>,
+                                                  std::common_type<S>>::type;
+            A acc[ 4 ] = { };
+            size_t i = 0;
+            for ( ; i + 4 <= n; i += 4 )
+                for ( size_t j = 0; j < 4; j++ )
+                    acc[ j ] += static_cast<A>( static_cast<S>( data[ i + j ] ) );
+            for ( ; i < n; i++ )
+                acc[ 0 ] += static_cast<A>( static_cast<S>( data[ i ] ) );
+            return static_cast<S>( ( acc[ 0 ] + acc[ 1 ] ) + ( acc[ 2 ] + acc[ 3 ] ) );
+        }
+
+        template <class T> auto min_scalar( const T *data, size_t n ) -> T
+        {
+            T ret = data[ 0 ];
+            for ( size_t i = 1; i < n; i++ )
+                if ( lt( data[ i ], ret ) )
+                    ret = data[ i ];
+            return ret;
+        }
+
+        template <class T> auto max_scalar( const T *data, size_t n ) -> T
+        {
+            T ret = data[ 0 ];
+            for ( size_t i = 1; i < n; i++ )
+                if ( lt( ret, data[ i ] ) )
+                    ret = data[ i ];
+            return ret;
+        }
+
+        template <class T> auto filter_scalar( const T *data, size_t n, Compare op, T a, T b, T *out ) -> size_t
+        {
+            size_t k = 0;
+            for ( size_t i = 0; i < n; i++ )
+            {
+                // branchless compaction, out[ k ] is overwritten if the value does not match
+                T v = data[ i ];
+                out[ k ] = v;
+                k += matches( v, op, a, b );
+            }
+            return k;
+        }
+
+#ifdef VROCKUTILS_AVX2_KERNELS
+        auto cpu_has_avx2( ) -> bool
+        {
+            static const bool supported = __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "popcnt" );
+            return supported;
+        }
+
+        /// permutation indices that move the selected 32 bit lanes to the front. for 64 bit lanes every selected lane
+        /// moves the two 32 bit halves
+        struct compaction_tables
+        {
+            alignas( 32 ) std::array<std::array<int32_t, 8>, 256> lanes32{ };
+            alignas( 32 ) std::array<std::array<int32_t, 8>, 16> lanes64{ };
+
+            compaction_tables( )
+            {
+                for ( size_t m = 0; m < 256; m++ )
+                    for ( int32_t b = 0, k = 0; b < 8; b++ )
+                        if ( m & ( 1u << b ) )
+                            lanes32[ m ][ k++ ] = b;
+                for ( size_t m = 0; m < 16; m++ )
+                    for ( int32_t b = 0, k = 0; b < 4; b++ )
+                        if ( m & ( 1u << b ) )
+                        {
+                            lanes64[ m ][ k++ ] = 2 * b;
+                            lanes64[ m ][ k++ ] = 2 * b + 1;
+                        }
+            }
+        };
+
+        const compaction_tables tables;
+
+        template <class T> VROCKUTILS_AVX2 auto reduce_lanes( __m256i v ) -> std::array<T, 32 / sizeof( T )>
+        {
+            std::array<T, 32 / sizeof( T )> lanes;
+            _mm256_storeu_si256( reinterpret_cast<__m256i *>( lanes.data( ) ), v );
+            return lanes;
+        }
+
+        VROCKUTILS_AVX2 auto sum_avx2( const int32_t *data, size_t n ) -> int64_t
+        {
+            __m256i acc0 = _mm256_setzero_si256( ), acc1 = _mm256_setzero_si256( );
+            size_t i = 0;
+            for ( ; i + 8 <= n; i += 8 )
+            {
+                __m256i v = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( data + i ) );
+                acc0 = _mm256_add_epi64( acc0, _mm256_cvtepi32_epi64( _mm256_castsi256_si128( v ) ) );
+                acc1 = _mm256_add_epi64( acc1, _mm256_cvtepi32_epi64( _mm256_extracti128_si256( v, 1 ) ) );
+            }
+            uint64_t ret = static_cast<uint64_t>( sum_scalar<int64_t>( data + i, n - i ) );
+            for ( auto l : reduce_lanes<uint64_t>( _mm256_add_epi64( acc0, acc1 ) ) )
+                ret += l;
+            return static_cast<int64_t>( ret );
+        }
+
+        VROCKUTILS_AVX2 auto sum_avx2( const int64_t *data, size_t n ) -> int64_t
+        {
+            __m256i acc0 = _mm256_setzero_si256( ), acc1 = _mm256_setzero_si256( );
+            size_t i = 0;
+            for ( ; i + 8 <= n; i += 8 )
+            {
+                acc0 = _mm256_add_epi64( acc0, _mm256_loadu_si256( reinterpret_cast<const __m256i *>( data + i ) ) );
+                acc1 =
+                    _mm256_add_epi64( acc1, _mm256_loadu_si256( reinterpret_cast<const __m256i *>( data + i + 4 ) ) );
+            }
+            uint64_t ret = static_cast<uint64_t>( sum_scalar<int64_t>( data + i, n - i ) );
+            for ( auto l : reduce_lanes<uint64_t>( _mm256_add_epi64( acc0, acc1 ) ) )
+                ret += l;
+            return static_cast<int64_t>( ret );
+        }
+
+        VROCKUTILS_AVX2 auto sum_avx2( const float *data, size_t n ) -> double
+        {
+            __m256d acc0 = _mm256_setzero_pd( ), acc1 = _mm256_setzero_pd( );
+            size_t i = 0;
+            for ( ; i + 8 <= n; i += 8 )
+            {
+                __m256 v = _mm256_loadu_ps( data + i );
+                acc0 = _mm256_add_pd( acc0, _mm256_cvtps_pd( _mm256_castps256_ps128( v ) ) );
+                acc1 = _mm256_add_pd( acc1, _mm256_cvtps_pd( _mm256_extractf128_ps( v, 1 ) ) );
+            }
+            alignas( 32 ) double lanes[ 4 ];
+            _mm256_store_pd( lanes, _mm256_add_pd( acc0, acc1 ) );
+            double ret = ( lanes[ 0 ] + lanes[ 1 ] ) + ( lanes[ 2 ] + lanes[ 3 ] );
+            return ret + sum_scalar<double>( data + i, n - i );
+        }
+
+        VROCKUTILS_AVX2 auto sum_avx2( const double *data, size_t n ) -> double
+        {
+            __m256d acc0 = _mm256_setzero_pd( ), acc1 = _mm256_setzero_pd( );
+            size_t i = 0;
+            for ( ; i + 8 <= n; i += 8 )
+            {
+                acc0 = _mm256_add_pd( acc0, _mm256_loadu_pd( data + i ) );
+                acc1 = _mm256_add_pd( acc1, _mm256_loadu_pd( data + i + 4 ) );
+            }
+            alignas( 32 ) double lanes[ 4 ];
+            _mm256_store_pd( lanes, _mm256_add_pd( acc0, acc1 ) );
+            double ret = ( lanes[ 0 ] + lanes[ 1 ] ) + ( lanes[ 2 ] + lanes[ 3 ] );
+            return ret + sum_scalar<double>( data + i, n - i );
+        }
+
+        template <bool Max> VROCKUTILS_AVX2 auto extreme_avx2( const int32_t *data, size_t n ) -> int32_t
+        {
+            __m256i acc = _mm256_set1_epi32( data[ 0 ] );
+            size_t i = 0;
+            for ( ; i + 8 <= n; i += 8 )
+            {
+                __m256i v = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( data + i ) );
+                acc = Max ? _mm256_max_epi32( acc, v ) : _mm256_min_epi32( acc, v );
+            }
+            int32_t ret = data[ 0 ];
+            for ( auto l : reduce_lanes<int32_t>( acc ) )
+                ret = Max ? std::max( ret, l ) : std::min( ret, l );
+            for ( ; i < n; i++ )
+                ret = Max ? std::max( ret, data[ i ] ) : std::min( ret, data[ i ] );
+            return ret;
+        }
+
+        template <bool Max> VROCKUTILS_AVX2 auto extreme_avx2( const int64_t *data, size_t n ) -> int64_t
+        {
+            __m256i acc = _mm256_set1_epi64x( data[ 0 ] );
+            size_t i = 0;
+            for ( ; i + 4 <= n; i += 4 )
+            {
+                __m256i v = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( data + i ) );
+                __m256i replace = Max ? _mm256_cmpgt_epi64( v, acc ) : _mm256_cmpgt_epi64( acc, v );
+                acc = _mm256_blendv_epi8( acc, v, replace );
+            }
+            int64_t ret = data[ 0 ];
+            for ( auto l : reduce_lanes<int64_t>( acc ) )
+                ret = Max ? std::max( ret, l ) : std::min( ret, l );
+            for ( ; i < n; i++ )
+                ret = Max ? std::max( ret, data[ i ] ) : std::min( ret, data[ i ] );
+            return ret;
+        }
+
+        // NaN lanes are replaced by the neutral element. min only returns NaN if every value is NaN, max returns NaN
+        // as soon as one value is NaN. in both cases the scalar kernel picks the same NaN as less() would.
+
+        VROCKUTILS_AVX2 auto min_avx2( const float *data, size_t n ) -> float
+        {
+            const __m256 inf = _mm256_set1_ps( std::numeric_limits<float>::infinity( ) );
+            __m256 acc = inf, ordered = _mm256_setzero_ps( );
+            size_t i = 0;
+            for ( ; i + 8 <= n; i += 8 )
+            {
+                __m256 v = _mm256_loadu_ps( data + i );
+                __m256 ord = _mm256_cmp_ps( v, v, _CMP_ORD_Q );
+                acc = _mm256_min_ps( acc, _mm256_blendv_ps( inf, v, ord ) );
+                ordered = _mm256_or_ps( ordered, ord );
+            }
+            if ( !_mm256_movemask_ps( ordered ) )
+                return min_scalar( data, n );
+            alignas( 32 ) float lanes[ 8 ];
+            _mm256_store_ps( lanes, acc );
+            float ret = min_scalar( lanes, 8 );
+            return i < n ? min_scalar( std::array<float, 2>{ ret, min_scalar( data + i, n - i ) }.data( ), 2 ) : ret;
+        }
+
+        VROCKUTILS_AVX2 auto min_avx2( const double *data, size_t n ) -> double
+        {
+            const __m256d inf = _mm256_set1_pd( std::numeric_limits<double>::infinity( ) );
+            __m256d acc = inf, ordered = _mm256_setzero_pd( );
+            size_t i = 0;
+            for ( ; i + 4 <= n; i += 4 )
+            {
+                __m256d v = _mm256_loadu_pd( data + i );
+                __m256d ord = _mm256_cmp_pd( v, v, _CMP_ORD_Q );
+                acc = _mm256_min_pd( acc, _mm256_blendv_pd( inf, v, ord ) );
+                ordered = _mm256_or_pd( ordered, ord );
+            }
+            if ( !_mm256_movemask_pd( ordered ) )
+                return min_scalar( data, n );
+            alignas( 32 ) double lanes[ 4 ];
+            _mm256_store_pd( lanes, acc );
+            double ret = min_scalar( lanes, 4 );
+            return i < n ? min_scalar( std::array<double, 2>{ ret, min_scalar( data + i, n - i ) }.data( ), 2 ) : ret;
+        }
+
+        VROCKUTILS_AVX2 auto max_avx2( const float *data, size_t n ) -> float
+        {
+            __m256 acc = _mm256_set1_ps( -std::numeric_limits<float>::infinity( ) ), unordered = _mm256_setzero_ps( );
+            size_t i = 0;
+            for ( ; i + 8 <= n; i += 8 )
+            {
+                __m256 v = _mm256_loadu_ps( data + i );
+                unordered = _mm256_or_ps( unordered, _mm256_cmp_ps( v, v, _CMP_UNORD_Q ) );
+                acc = _mm256_max_ps( v, acc ); // returns acc if v is NaN
+            }
+            if ( _mm256_movemask_ps( unordered ) )
+                return max_scalar( data, n );
+            alignas( 32 ) float lanes[ 8 ];
+            _mm256_store_ps( lanes, acc );
+            float ret = max_scalar( lanes, 8 );
+            return i < n ? max_scalar( std::array<float, 2>{ ret, max_scalar( data + i, n - i ) }.data( ), 2 ) : ret;
+        }
+
+        VROCKUTILS_AVX2 auto max_avx2( const double *data, size_t n ) -> double
+        {
+            __m256d acc = _mm256_set1_pd( -std::numeric_limits<double>::infinity( ) ), unordered = _mm256_setzero_pd( );
+            size_t i = 0;
+            for ( ; i + 4 <= n; i += 4 )
+            {
+                __m256d v = _mm256_loadu_pd( data + i );
+                unordered = _mm256_or_pd( unordered, _mm256_cmp_pd( v, v, _CMP_UNORD_Q ) );
+                acc = _mm256_max_pd( v, acc ); // returns acc if v is NaN
+            }
+            if ( _mm256_movemask_pd( unordered ) )
+                return max_scalar( data, n );
+            alignas( 32 ) double lanes[ 4 ];
+            _mm256_store_pd( lanes, acc );
+            double ret = max_scalar( lanes, 4 );
+            return i < n ? max_scalar( std::array<double, 2>{ ret, max_scalar( data + i, n - i ) }.data( ), 2 ) : ret;
+        }
+
+        // comparison masks, one bit per lane. a and b are never NaN here, so the ordered predicates match less()
+        // except for greater, where NaN values have to be selected as well.
+
+        VROCKUTILS_AVX2 auto mask( __m256i v, Compare op, __m256i a, __m256i b, int32_t ) -> unsigned
+        {
+            __m256i m;
+            switch ( op )
+            {
+            case Compare::less:
+                m = _mm256_cmpgt_epi32( a, v );
+                break;
+            case Compare::greater:
+                m = _mm256_cmpgt_epi32( v, a );
+                break;
+            case Compare::equal:
+                m = _mm256_cmpeq_epi32( v, a );
+                break;
+            default:
+                m = _mm256_or_si256( _mm256_cmpgt_epi32( a, v ), _mm256_cmpgt_epi32( v, b ) );
+                return ~static_cast<unsigned>( _mm256_movemask_ps( _mm256_castsi256_ps( m ) ) ) & 0xffu;
+            }
+            return static_cast<unsigned>( _mm256_movemask_ps( _mm256_castsi256_ps( m ) ) );
+        }
+
+        VROCKUTILS_AVX2 auto mask( __m256i v, Compare op, __m256i a, __m256i b, int64_t ) -> unsigned
+        {
+            __m256i m;
+            switch ( op )
+            {
+            case Compare::less:
+                m = _mm256_cmpgt_epi64( a, v );
+                break;
+            case Compare::greater:
+                m = _mm256_cmpgt_epi64( v, a );
+                break;
+            case Compare::equal:
+                m = _mm256_cmpeq_epi64( v, a );
+                break;
+            default:
+                m = _mm256_or_si256( _mm256_cmpgt_epi64( a, v ), _mm256_cmpgt_epi64( v, b ) );
+                return ~static_cast<unsigned>( _mm256_movemask_pd( _mm256_castsi256_pd( m ) ) ) & 0xfu;
+            }
+            return static_cast<unsigned>( _mm256_movemask_pd( _mm256_castsi256_pd( m ) ) );
+        }
+
+        VROCKUTILS_AVX2 auto mask( __m256i vi, Compare op, __m256i ai, __m256i bi, float ) -> unsigned
+        {
+            __m256 v = _mm256_castsi256_ps( vi ), a = _mm256_castsi256_ps( ai ), b = _mm256_castsi256_ps( bi );
+            switch ( op )
+            {
+            case Compare::less:
+                return static_cast<unsigned>( _mm256_movemask_ps( _mm256_cmp_ps( v, a, _CMP_LT_OQ ) ) );
+            case Compare::greater:
+                return static_cast<unsigned>( _mm256_movemask_ps( _mm256_cmp_ps( v, a, _CMP_NLE_UQ ) ) );
+            case Compare::equal:
+                return static_cast<unsigned>( _mm256_movemask_ps( _mm256_cmp_ps( v, a, _CMP_EQ_OQ ) ) );
+            default:
+                return static_cast<unsigned>( _mm256_movemask_ps(
+                    _mm256_and_ps( _mm256_cmp_ps( v, a, _CMP_GE_OQ ), _mm256_cmp_ps( v, b, _CMP_LE_OQ ) ) ) );
+            }
+        }
+
+        VROCKUTILS_AVX2 auto mask( __m256i vi, Compare op, __m256i ai, __m256i bi, double ) -> unsigned
+        {
+            __m256d v = _mm256_castsi256_pd( vi ), a = _mm256_castsi256_pd( ai ), b = _mm256_castsi256_pd( bi );
+            switch ( op )
+            {
+            case Compare::less:
+                return static_cast<unsigned>( _mm256_movemask_pd( _mm256_cmp_pd( v, a, _CMP_LT_OQ ) ) );
+            case Compare::greater:
+                return static_cast<unsigned>( _mm256_movemask_pd( _mm256_cmp_pd( v, a, _CMP_NLE_UQ ) ) );
+            case Compare::equal:
+                return static_cast<unsigned>( _mm256_movemask_pd( _mm256_cmp_pd( v, a, _CMP_EQ_OQ ) ) );
+            default:
+                return static_cast<unsigned>( _mm256_movemask_pd(
+                    _mm256_and_pd( _mm256_cmp_pd( v, a, _CMP_GE_OQ ), _mm256_cmp_pd( v, b, _CMP_LE_OQ ) ) ) );
+            }
+        }
+
+        template <class T> VROCKUTILS_AVX2 auto broadcast( T v ) -> __m256i
+        {
+            constexpr size_t lanes = 32 / sizeof( T );
+            std::array<T, lanes> values;
+            values.fill( v );
+            return _mm256_loadu_si256( reinterpret_cast<const __m256i *>( values.data( ) ) );
+        }
+
+        template <class T>
+        VROCKUTILS_AVX2 auto filter_avx2( const T *data, size_t n, Compare op, T a, T b, T *out ) -> size_t
+        {
+            constexpr size_t lanes = 32 / sizeof( T );
+            const auto &perms = []( ) -> const auto & {
+                if constexpr ( lanes == 8 )
+                    return tables.lanes32;
+                else
+                    return tables.lanes64;
+            }( );
+            const __m256i va = broadcast( a ), vb = broadcast( b );
+            size_t i = 0, k = 0;
+            for ( ; i + lanes <= n; i += lanes )
+            {
+                // k <= i, so the full store stays inside the first n values of out even when data == out
+                __m256i v = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( data + i ) );
+                unsigned bits = mask( v, op, va, vb, T( ) );
+                __m256i perm = _mm256_load_si256( reinterpret_cast<const __m256i *>( perms[ bits ].data( ) ) );
+                _mm256_storeu_si256( reinterpret_cast<__m256i *>( out + k ), _mm256_permutevar8x32_epi32( v, perm ) );
+                k += static_cast<size_t>( __builtin_popcount( bits ) );
+            }
+            return k + filter_scalar( data + i, n - i, op, a, b, out + k );
+        }
+#else
+        auto cpu_has_avx2( ) -> bool
+        {
+            return false;
+        }
+#endif
+
+        auto dispatch_avx2( ) -> bool
+        {
+            return use_simd.load( std::memory_order_relaxed ) && cpu_has_avx2( );
+        }
+
+        template <class S, class T> auto sum_impl( const T *data, size_t n ) -> S
+        {
+#ifdef VROCKUTILS_AVX2_KERNELS
+            if ( dispatch_avx2( ) )
+                return sum_avx2( data, n );
+#endif
+            return sum_scalar<S>( data, n );
+        }
+
+        template <class T> auto min_impl( const T *data, size_t n ) -> T
+        {
+#ifdef VROCKUTILS_AVX2_KERNELS
+            if ( dispatch_avx2( ) )
+            {
+                if constexpr ( std::is_integral_v<T> )
+                    return extreme_avx2<false>( data, n );
+                else
+                    return min_avx2( data, n );
+            }
+#endif
+            return min_scalar( data, n );
+        }
+
+        template <class T> auto max_impl( const T *data, size_t n ) -> T
+        {
+#ifdef VROCKUTILS_AVX2_KERNELS
+            if ( dispatch_avx2( ) )
+            {
+                if constexpr ( std::is_integral_v<T> )
+                    return extreme_avx2<true>( data, n );
+                else
+                    return max_avx2( data, n );
+            }
+#endif
+            return max_scalar( data, n );
+        }
+
+        template <class T> auto filter_impl( const T *data, size_t n, Compare op, T a, T b, T *out ) -> size_t
+        {
+#ifdef VROCKUTILS_AVX2_KERNELS
+            // NaN bounds have no ordered vector predicate, they are rare enough to take the scalar path
+            if ( dispatch_avx2( ) && !is_nan( a ) && !is_nan( b ) )
+                return filter_avx2( data, n, op, a, b, out );
+#endif
+            return filter_scalar( data, n, op, a, b, out );
+        }
+    } // namespace
+
+    auto has_avx2( ) -> bool
+    {
+        return cpu_has_avx2( );
+    }
+
+    auto set_simd_enabled( bool enabled ) -> void
+    {
+        use_simd.store( enabled, std::memory_order_relaxed );
+    }
+
+    auto simd_enabled( ) -> bool
+    {
+        return dispatch_avx2( );
+    }
+
+    auto sum( const int32_t *data, size_t n ) -> int64_t
+    {
+        return sum_impl<int64_t>( data, n );
+    }
+    auto sum( const int64_t *data, size_t n ) -> int64_t
+    {
+        return sum_impl<int64_t>( data, n );
+    }
+    auto sum( const float *data, size_t n ) -> double
+    {
+        return sum_impl<double>( data, n );
+    }
+    auto sum( const double *data, size_t n ) -> double
+    {
+        return sum_impl<double>( data, n );
+    }
+
+    auto min( const int32_t *data, size_t n ) -> int32_t
+    {
+        return min_impl( data, n );
+    }
+    auto min( const int64_t *data, size_t n ) -> int64_t
+    {
+        return min_impl( data, n );
+    }
+    auto min( const float *data, size_t n ) -> float
+    {
+        return min_impl( data, n );
+    }
+    auto min( const double *data, size_t n ) -> double
+    {
+        return min_impl( data, n );
+    }
+
+    auto max( const int32_t *data, size_t n ) -> int32_t
+    {
+        return max_impl( data, n );
+    }
+    auto max( const int64_t *data, size_t n ) -> int64_t
+    {
+        return max_impl( data, n );
+    }
+    auto max( const float *data, size_t n ) -> float
+    {
+        return max_impl( data, n );
+    }
+    auto max( const double *data, size_t n ) -> double
+    {
+        return max_impl( data, n );
+    }
+
+    auto filter( const int32_t *data, size_t n, Compare op, int32_t a, int32_t b, int32_t *out ) -> size_t
+    {
+        return filter_impl( data, n, op, a, b, out );
+    }
+    auto filter( const int64_t *data, size_t n, Compare op, int64_t a, int64_t b, int64_t *out ) -> size_t
+    {
+        return filter_impl( data, n, op, a, b, out );
+    }
+    auto filter( const float *data, size_t n, Compare op, float a, float b, float *out ) -> size_t
+    {
+        return filter_impl( data, n, op, a, b, out );
+    }
+    auto filter( const double *data, size_t n, Compare op, double a, double b, double *out ) -> size_t
+    {
+        return filter_impl( data, n, op, a, b, out );
+    }
+} // namespace vrock::utils::kernels
@@ -0,0 +1,99 @@
+#include "vrock/utils/Serialize.hpp"
+
+#include <array>
+#include <bit>
+
+namespace vrock::utils
+{
+    namespace
+    {
+        constexpr uint32_t magic = 0x4c555256; // "VRUL"
+        constexpr uint16_t version = 1;
+        constexpr uint8_t native_endian = std::endian::native == std::endian::little ? 1 : 2;
+
+        constexpr auto make_crc_table( ) -> std::array<uint32_t, 256>
+        {
+            auto table = std::array<uint32_t, 256>( );
+            for ( uint32_t i = 0; i < 256; i++ )
+            {
+                uint32_t c = i;
+                for ( int k = 0; k < 8; k++ )
+                    c = c & 1 ? 0xedb88320u ^ ( c >> 1 ) : c >> 1;
+                table[ i ] = c;
+            }
+            return table;
+        }
+
+        constexpr auto crc_table = make_crc_table( );
+
+        /// checksum of the header with a zeroed crc field followed by the payload
+        auto checksum( const uint8_t *data, const detail::SerialHeader &header ) -> uint32_t
+        {
+            auto h = header;
+            h.crc = 0;
+            auto crc = crc32( reinterpret_cast<const uint8_t *>( &h ), sizeof( h ) );
+            return crc32( data + detail::serial_header_size, header.payload, crc );
+        }
+    } // namespace
+
+    auto crc32( const uint8_t *data, size_t length, uint32_t crc ) -> uint32_t
+    {
+        crc = ~crc;
+        for ( size_t i = 0; i < length; i++ )
+            crc = crc_table[ ( crc ^ data[ i ] ) & 0xff ] ^ ( crc >> 8 );
+        return ~crc;
+    }
+
+    namespace detail
+    {
+        auto write_header( uint8_t *data, Layout layout, uint32_t type_id, uint64_t count, uint64_t payload ) -> void
+        {
+            auto header = SerialHeader{ magic, version, static_cast<uint8_t>( layout ), native_endian, type_id, 0,
+                                        count, payload };
+            header.crc = checksum( data, header );
+            std::memcpy( data, &header, sizeof( header ) );
+        }
+
+        auto read_header( const uint8_t *data, size_t length, uint32_t type_id, bool verify ) -> SerialHeader
+        {
+            if ( data == nullptr || length < serial_header_size )
+                throw std::runtime_error( "truncated data" );
+            auto header = SerialHeader( );
+            std::memcpy( &header, data, sizeof( header ) );
+            if ( header.magic != magic )
+                throw std::runtime_error( "not serialized by vrock.utils" );
+            if ( header.version != version )
+                throw std::runtime_error( "unsupported serialization version" );
+            if ( header.endian != native_endian )
+                throw std::runtime_error( "data was written with a different byte order" );
+            if ( header.type_id != type_id )
+                throw std::runtime_error( "data was written for a different type" );
+            if ( header.payload > length - serial_header_size )
+                throw std::runtime_error( "truncated data" );
+            // count is compared by division first, so a forged count cannot wrap the product around to the payload
+            uint64_t element = type_id & raw_size_mask;
+            if ( header.layout == static_cast<uint8_t>( Layout::raw ) &&
+                 ( element == 0 || header.count > header.payload / element ||
+                   header.count * element != header.payload ) )
+                throw std::runtime_error( "payload size does not match the data" );
+            if ( verify && checksum( data, header ) != header.crc )
+                throw std::runtime_error( "checksum mismatch" );
+            return header;
+        }
+
+        auto read_varint( const uint8_t *&p, const uint8_t *end ) -> uint64_t
+        {
+            uint64_t v = 0;
+            for ( int shift = 0; shift < 64; shift += 7 )
+            {
+                if ( p == end )
+                    throw std::runtime_error( "truncated data" );
+                auto b = *p++;
+                v |= static_cast<uint64_t>( b & 0x7f ) << shift;
+                if ( ( b & 0x80 ) == 0 )
+                    return v;
+            }
+            throw std::runtime_error( "invalid varint" );
+        }
+    } // namespace detail
+} // namespace vrock::utils
@@ -0,0 +1,157 @@
+#include "vrock/utils/Trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <utility>
+
+namespace vrock::utils::trace
+{
+    namespace
+    {
+        std::mutex sink_mutex;
+        std::shared_ptr<Sink> current_sink;
+        std::atomic<bool> sink_set{ false };
+        std::atomic<size_t ( * )( )> allocation_counter{ nullptr };
+    } // namespace
+
+    CallbackSink::CallbackSink( std::function<void( const Event & )> callback ) : callback( std::move( callback ) )
+    {
+    }
+
+    auto CallbackSink::record( const Event &e ) -> void
+    {
+        auto lock = std::lock_guard( mutex );
+        callback( e );
+    }
+
+    RingSink::RingSink( size_t capacity ) : ring( std::max<size_t>( 1, capacity ) )
+    {
+    }
+
+    auto RingSink::record( const Event &e ) -> void
+    {
+        auto lock = std::lock_guard( mutex );
+        ring[ next ] = e;
+        next = ( next + 1 ) % ring.size( );
+        total++;
+    }
+
+    auto RingSink::events( ) const -> std::vector<Event>
+    {
+        auto lock = std::lock_guard( mutex );
+        auto ret = std::vector<Event>( );
+        if ( total < ring.size( ) )
+            ret.assign( ring.begin( ), ring.begin( ) + static_cast<std::ptrdiff_t>( total ) );
+        else
+        {
+            ret.assign( ring.begin( ) + static_cast<std::ptrdiff_t>( next ), ring.end( ) );
+            ret.insert( ret.end( ), ring.begin( ), ring.begin( ) + static_cast<std::ptrdiff_t>( next ) );
+        }
+        return ret;
+    }
+
+    auto RingSink::dropped( ) const -> size_t
+    {
+        auto lock = std::lock_guard( mutex );
+        return total > ring.size( ) ? total - ring.size( ) : 0;
+    }
+
+    auto RingSink::clear( ) -> void
+    {
+        auto lock = std::lock_guard( mutex );
+        next = 0;
+        total = 0;
+    }
+
+    ChromeTraceSink::ChromeTraceSink( std::string path ) : path( std::move( path ) )
+    {
+    }
+
+    ChromeTraceSink::~ChromeTraceSink( )
+    {
+        flush( );
+    }
+
+    auto ChromeTraceSink::record( const Event &e ) -> void
+    {
+        auto lock = std::lock_guard( mutex );
+        events.push_back( e );
+    }
+
+    auto ChromeTraceSink::flush( ) -> void
+    {
+        auto lock = std::lock_guard( mutex );
+        auto out = std::ofstream( path, std::ios::trunc );
+        out << "{\"traceEvents\":[\n";
+        for ( size_t i = 0; i < events.size( ); i++ )
+        {
+            const auto &e = events[ i ];
+            char line[ 384 ];
+            // complete events ("ph":"X"), timestamps and durations in microseconds
+            std::snprintf( line, sizeof( line ),
+                           "{\"name\":\"%s\",\"cat\":\"vrockutils\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,"
+                           "\"tid\":%llu,\"args\":{\"input\":%zu,\"output\":%zu,\"bytes\":%zu}}%s\n",
+                           e.op, static_cast<double>( e.start_ns ) / 1e3, static_cast<double>( e.duration_ns ) / 1e3,
+                           static_cast<unsigned long long>( e.thread ), e.input, e.output, e.bytes,
+                           i + 1 < events.size( ) ? "," : "" );
+            out << line;
+        }
+        out << "]}\n";
+    }
+
+    auto set_sink( std::shared_ptr<Sink> sink ) -> void
+    {
+        auto lock = std::lock_guard( sink_mutex );
+        sink_set = sink != nullptr;
+        current_sink = std::move( sink );
+    }
+
+    auto get_sink( ) -> std::shared_ptr<Sink>
+    {
+        auto lock = std::lock_guard( sink_mutex );
+        return current_sink;
+    }
+
+    auto enabled( ) -> bool
+    {
+        return sink_set.load( std::memory_order_relaxed );
+    }
+
+    auto emit( const Event &e ) -> void
+    {
+        if ( auto sink = get_sink( ) )
+            sink->record( e );
+    }
+
+    auto set_allocation_counter( size_t ( *counter )( ) ) -> void
+    {
+        allocation_counter = counter;
+    }
+
+    auto allocated_bytes( ) -> size_t
+    {
+        auto *counter = allocation_counter.load( );
+        return counter ? counter( ) : 0;
+    }
+
+    auto has_allocation_counter( ) -> bool
+    {
+        return allocation_counter.load( ) != nullptr;
+    }
+
+    auto now_ns( ) -> int64_t
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now( ).time_since_epoch( ) )
+            .count( );
+    }
+
+    auto thread_id( ) -> uint64_t
+    {
+        return static_cast<uint64_t>( std::hash<std::thread::id>( )( std::this_thread::get_id( ) ) );
+    }
+} // namespace vrock::utils::trace
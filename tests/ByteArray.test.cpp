@@ -75,4 +75,16 @@ TEST( ByteArrayFromString, BasicAssertion )
 
     EXPECT_EQ( hex->to_string( ), "1234" );
     EXPECT_EQ( str->to_string( ), "1234" );
-}
\ No newline at end of file
+}
+
+TEST( ByteArrayAppend, BasicAssertion )
+{
+    auto arr = ByteArray::from_string( "12" );
+    arr->append( ByteArray::from_string( "3456" ) );
+    EXPECT_EQ( arr->length, 6 );
+    EXPECT_EQ( arr->to_string( ), "123456" );
+
+    arr = ByteArray::from_string( "1234" );
+    arr->append( ByteArray::from_string( "5" ) );
+    EXPECT_EQ( arr->to_string( ), "12345" );
+}
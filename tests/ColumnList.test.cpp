@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <vrock/utils/ColumnList.hpp>
+
+#include <string>
+
+struct Record
+{
+    int id{ };
+    double price{ };
+    std::string name;
+
+    friend bool operator==( const Record &lhs, const Record &rhs )
+    {
+        return lhs.id == rhs.id && lhs.price == rhs.price && lhs.name == rhs.name;
+    }
+};
+
+using Records = vrock::utils::ColumnList<Record, &Record::id, &Record::price, &Record::name>;
+
+static auto records( ) -> vrock::utils::List<Record>
+{
+    return vrock::utils::List<Record>(
+        { { 1, 2.5, "apple" }, { 2, 1.0, "pear" }, { 1, 4.0, "plum" }, { 3, 0.5, "fig" }, { 2, 3.0, "kiwi" } } );
+}
+
+TEST( ColumnListConvert, BasicAssertions )
+{
+    auto list = records( );
+    auto columns = Records( list );
+
+    EXPECT_EQ( columns.count( ), 5 );
+    EXPECT_EQ( columns.column<&Record::id>( ), std::vector<int>( { 1, 2, 1, 3, 2 } ) );
+    EXPECT_EQ( columns.at( 2 ), list[ 2 ] );
+    EXPECT_EQ( columns.to_list( ), list );
+}
+
+TEST( ColumnListScan, BasicAssertions )
+{
+    auto columns = Records( records( ) );
+
+    auto sel = columns.scan<&Record::price>( []( double p ) { return p > 1.0; } );
+    EXPECT_EQ( sel, Records::selection( { 0, 2, 4 } ) );
+
+    sel = columns.scan<&Record::id>( sel, []( int id ) { return id == 1; } );
+    EXPECT_EQ( sel, Records::selection( { 0, 2 } ) );
+    EXPECT_EQ( columns.select<&Record::name>( sel ), vrock::utils::List<std::string>( { "apple", "plum" } ) );
+
+    auto filtered = columns.where<&Record::id>( []( int id ) { return id == 2; } );
+    EXPECT_EQ( filtered.to_list( ), vrock::utils::List<Record>( { { 2, 1.0, "pear" }, { 2, 3.0, "kiwi" } } ) );
+}
+
+TEST( ColumnListAggregate, BasicAssertions )
+{
+    auto columns = Records( records( ) );
+
+    EXPECT_EQ( ( columns.aggregate<&Record::price, double>( []( double p, double s ) { return s + p; } ) ), 11.0 );
+
+    auto groups = columns.group_by<&Record::id>( );
+    EXPECT_EQ( groups.size( ), 3 );
+    EXPECT_EQ( groups[ 2 ], Records::selection( { 1, 4 } ) );
+
+    auto sums = columns.group_aggregate<&Record::id, &Record::price>( 0.0, []( double p, double s ) { return s + p; } );
+    EXPECT_EQ( sums[ 1 ], 6.5 );
+    EXPECT_EQ( sums[ 3 ], 0.5 );
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include <vrock/utils/Enumerable.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <string>
+
+using vrock::utils::Enumerable;
+using vrock::utils::List;
+
+static auto numbers( int n ) -> List<int>
+{
+    auto ret = List<int>( );
+    for ( int i = 0; i < n; i++ )
+        ret.push_back( i );
+    return ret;
+}
+
+TEST( EnumerableOperators, BasicAssertions )
+{
+    auto res = vrock::utils::from_list( numbers( 100 ), 8 )
+                   .where( []( int i ) { return i % 3 == 0; } )
+                   .select( []( int i ) { return i * 2; } )
+                   .skip( 2 )
+                   .take( 4 )
+                   .to_list( );
+    EXPECT_EQ( res, List<int>( { 12, 18, 24, 30 } ) );
+
+    auto it_sum = 0;
+    for ( auto i : vrock::utils::from_list( numbers( 10 ), 3 ) )
+        it_sum += i;
+    EXPECT_EQ( it_sum, 45 );
+}
+
+TEST( EnumerableTerminal, BasicAssertions )
+{
+    EXPECT_EQ( vrock::utils::from_list( numbers( 1000 ), 64 ).count( ), 1000 );
+    EXPECT_EQ( vrock::utils::from_list( numbers( 10 ), 4 ).aggregate<int>( []( int i, int s ) { return s + i; } ), 45 );
+    EXPECT_TRUE( vrock::utils::from_list( numbers( 10 ), 4 ).any( []( int i ) { return i == 7; } ) );
+    EXPECT_FALSE( vrock::utils::from_list( numbers( 10 ), 4 ).all( []( int i ) { return i < 7; } ) );
+    EXPECT_EQ( vrock::utils::from_list( numbers( 10 ), 4 ).first( []( int i ) { return i > 4; } ), 5 );
+
+    auto groups = vrock::utils::from_list( numbers( 10 ), 4 ).group_by( []( int i ) { return i % 3; } );
+    EXPECT_EQ( groups[ 1 ], List<int>( { 1, 4, 7 } ) );
+    auto sums = vrock::utils::from_list( numbers( 10 ), 4 ).group_aggregate( []( int i ) { return i % 2; }, 0,
+                                                                             []( int i, int s ) { return s + i; } );
+    EXPECT_EQ( sums[ 0 ], 20 );
+    EXPECT_EQ( sums[ 1 ], 25 );
+}
+
+TEST( EnumerableFile, BasicAssertions )
+{
+    const auto path = std::string( "enumerable_test.txt" );
+    {
+        auto file = std::ofstream( path, std::ios::binary );
+        for ( int i = 0; i < 500; i++ )
+            file << "record " << i << "\n";
+        file << "last";
+    }
+
+    // chunks of 7 bytes force records to span chunk borders
+    auto records = vrock::utils::split( vrock::utils::read_chunks( path, 7 ), '\n', 16 );
+    auto lengths = std::move( records ).select( []( const std::string &s ) { return s.size( ); } ).to_list( );
+    EXPECT_EQ( lengths.size( ), 501 );
+    EXPECT_EQ( lengths[ 0 ], 8 );
+    EXPECT_EQ( lengths[ 499 ], 10 );
+    EXPECT_EQ( lengths[ 500 ], 4 );
+
+    auto matches = vrock::utils::prefetch( vrock::utils::split( vrock::utils::read_chunks( path, 64 ) ), 3 )
+                       .where( []( const std::string &s ) { return s.find( "99" ) != std::string::npos; } )
+                       .to_list( );
+    EXPECT_EQ( matches, List<std::string>( { "record 99", "record 199", "record 299", "record 399", "record 499" } ) );
+
+    std::remove( path.c_str( ) );
+    EXPECT_THROW( vrock::utils::read_chunks( path ), std::runtime_error );
+}
+
+struct detached
+{
+    struct promise_type
+    {
+        auto get_return_object( ) -> detached
+        {
+            return { };
+        }
+        auto initial_suspend( ) noexcept -> std::suspend_never
+        {
+            return { };
+        }
+        auto final_suspend( ) noexcept -> std::suspend_never
+        {
+            return { };
+        }
+        auto return_void( ) -> void
+        {
+        }
+        auto unhandled_exception( ) -> void
+        {
+            std::terminate( );
+        }
+    };
+};
+
+static auto consume( vrock::utils::AsyncEnumerable<int> &source, std::promise<int> &result ) -> detached
+{
+    int sum = 0;
+    while ( auto batch = co_await source.next_batch( ) )
+        for ( auto i : *batch )
+            sum += i;
+    result.set_value( sum );
+}
+
+TEST( EnumerableAsync, BasicAssertions )
+{
+    auto source = vrock::utils::AsyncEnumerable<int>( vrock::utils::from_list( numbers( 1000 ), 10 ), 4 );
+    auto result = std::promise<int>( );
+    auto sum = result.get_future( );
+    consume( source, result );
+    EXPECT_EQ( sum.get( ), 499500 );
+}
+
+static auto consume_owned( Enumerable<int> source, vrock::utils::AsyncEnumerable<int>::scheduler resume,
+                           std::promise<int> &result ) -> detached
+{
+    int sum = 0;
+    {
+        // the stream is destroyed inside the coroutine, on the thread that resumed it last
+        auto async = vrock::utils::AsyncEnumerable<int>( std::move( source ), 2, std::move( resume ) );
+        while ( auto batch = co_await async.next_batch( ) )
+            for ( auto i : *batch )
+                sum += i;
+    }
+    result.set_value( sum );
+}
+
+TEST( EnumerableAsyncOwned, BasicAssertions )
+{
+    auto resumed = std::promise<int>( );
+    auto sum = resumed.get_future( );
+    consume_owned( vrock::utils::from_list( numbers( 1000 ), 10 ), nullptr, resumed );
+    EXPECT_EQ( sum.get( ), 499500 );
+
+    // resuming inline finishes the coroutine on the producer thread, which must not join itself
+    auto inline_resumed = std::promise<int>( );
+    sum = inline_resumed.get_future( );
+    consume_owned(
+        vrock::utils::from_list( numbers( 1000 ), 10 ), []( std::coroutine_handle<> h ) { h.resume( ); },
+        inline_resumed );
+    EXPECT_EQ( sum.get( ), 499500 );
+}
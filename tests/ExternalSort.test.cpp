@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <vrock/utils/ExternalSort.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <random>
+#include <string>
+
+using namespace vrock::utils;
+
+struct Order
+{
+    int customer{ };
+    std::string item;
+    int sequence{ };
+};
+
+namespace
+{
+    auto random_ints( size_t n, unsigned seed ) -> List<int>
+    {
+        auto rng = std::mt19937( seed );
+        auto dist = std::uniform_int_distribution<int>( -100000, 100000 );
+        auto ret = List<int>( );
+        for ( size_t i = 0; i < n; i++ )
+            ret.push_back( dist( rng ) );
+        return ret;
+    }
+
+    auto count_runs( const std::string &directory ) -> size_t
+    {
+        size_t n = 0;
+        for ( const auto &entry : std::filesystem::directory_iterator( directory ) )
+            n += entry.path( ).extension( ) == ".run";
+        return n;
+    }
+} // namespace
+
+TEST( ExternalSortSpill, BasicAssertions )
+{
+    auto directory = std::filesystem::temp_directory_path( ) / "vrockutils-external-sort-test";
+    std::filesystem::create_directories( directory );
+    auto values = random_ints( 50000, 5 );
+    auto expected = values;
+    std::sort( expected.begin( ), expected.end( ) );
+
+    // runs of 1024 ints in blocks of 64 ints, the fan in of 8 forces several merge passes
+    auto options = ExternalSortOptions( );
+    options.memory_budget = 1024 * sizeof( int );
+    options.block_bytes = 64 * sizeof( int );
+    options.temp_directory = directory.string( );
+    options.batch_size = 100;
+    for ( size_t threads : { 1, 4 } )
+    {
+        options.threads = threads;
+        auto sorted = external_sort( from_list( values ), options );
+        auto *first = sorted.next_batch( );
+        ASSERT_NE( first, nullptr );
+        EXPECT_EQ( first->size( ), 100 );
+        EXPECT_GT( count_runs( directory.string( ) ), 0 );
+        auto result = *first;
+        result.concat( sorted.to_list( ) );
+        EXPECT_EQ( result, expected ) << threads;
+    }
+    // the temporary files are removed once the stream is destroyed
+    EXPECT_EQ( count_runs( directory.string( ) ), 0 );
+
+    // everything fits into memory, no files are written
+    options.memory_budget = size_t( 1 ) << 20;
+    auto descending = external_sort( from_list( values ), []( int a, int b ) { return a > b; }, options );
+    auto result = descending.to_list( );
+    std::reverse( expected.begin( ), expected.end( ) );
+    EXPECT_EQ( result, expected );
+
+    EXPECT_TRUE( external_sort( from_list( List<int>( ) ), options ).to_list( ).empty( ) );
+    options.memory_budget = 0;
+    EXPECT_THROW( external_sort( from_list( values ), options ), std::invalid_argument );
+    std::filesystem::remove_all( directory );
+}
+
+TEST( ExternalSortSchema, BasicAssertions )
+{
+    auto orders = List<Order>( );
+    for ( int i = 0; i < 3000; i++ )
+        orders.push_back( { ( i * 7919 ) % 101, "item-" + std::to_string( i % 13 ), i } );
+
+    auto options = ExternalSortOptions( );
+    options.memory_budget = 200 * sizeof( Order );
+    options.block_bytes = 16 * sizeof( Order );
+    options.threads = 3;
+    auto codec = schema( &Order::customer, &Order::item, &Order::sequence );
+    auto by_customer = []( const Order &a, const Order &b ) { return a.customer < b.customer; };
+
+    auto path = ( std::filesystem::temp_directory_path( ) / "vrockutils-external-sort-orders.bin" ).string( );
+    external_sort_to_file( from_list( orders ), path, by_customer, options, codec );
+    auto result = read_blocks<Order>( path, codec ).to_list( );
+    std::filesystem::remove( path );
+
+    ASSERT_EQ( result.size( ), orders.size( ) );
+    for ( size_t i = 1; i < result.size( ); i++ )
+    {
+        ASSERT_LE( result[ i - 1 ].customer, result[ i ].customer );
+        // stable: orders of the same customer keep their input order
+        if ( result[ i - 1 ].customer == result[ i ].customer )
+        {
+            ASSERT_LT( result[ i - 1 ].sequence, result[ i ].sequence );
+        }
+    }
+    EXPECT_EQ( result[ 0 ].item, "item-" + std::to_string( result[ 0 ].sequence % 13 ) );
+    EXPECT_THROW( read_blocks<Order>( path, codec ), std::runtime_error );
+}
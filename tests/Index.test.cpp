@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <vrock/utils/ObservableList.hpp>
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+
+using namespace vrock::utils;
+
+struct Account
+{
+    int id{ };
+    std::string owner;
+    double balance{ };
+
+    friend bool operator==( const Account &lhs, const Account &rhs )
+    {
+        return lhs.id == rhs.id && lhs.owner == rhs.owner && lhs.balance == rhs.balance;
+    }
+};
+
+static auto accounts( ) -> List<Account>
+{
+    return List<Account>(
+        { { 1, "ann", 10.0 }, { 2, "bob", 5.5 }, { 3, "ann", 7.0 }, { 4, "eve", 12.0 }, { 5, "bob", 5.5 } } );
+}
+
+TEST( ListHashIndex, BasicAssertions )
+{
+    auto list = accounts( );
+    auto by_id = list.index_by( &Account::id, true );
+    auto by_owner = list.index_by( []( const Account &a ) { return a.owner; } );
+
+    EXPECT_EQ( by_id.single( 3 ).owner, "ann" );
+    EXPECT_TRUE( by_id.contains( 5 ) );
+    EXPECT_FALSE( by_id.contains( 6 ) );
+    EXPECT_THROW( by_id.first( 6 ), std::runtime_error );
+    EXPECT_EQ( by_id.first_or_default( 6, { 0, "none", 0.0 } ).owner, "none" );
+
+    EXPECT_EQ( by_owner.count( "ann" ), 2 );
+    EXPECT_EQ( by_owner.first( "bob" ).id, 2 );
+    EXPECT_EQ( by_owner.where( "ann" ), list.where( []( const Account &a ) { return a.owner == "ann"; } ) );
+    EXPECT_EQ( by_owner.positions( "bob" ), std::vector<size_t>( { 1, 4 } ) );
+    EXPECT_THROW( by_owner.single( "bob" ), std::runtime_error );
+
+    // modifications are picked up on the next lookup
+    list.where_inplace( []( const Account &a ) { return a.owner != "ann"; } );
+    EXPECT_FALSE( by_id.contains( 1 ) );
+    EXPECT_EQ( by_owner.count( "ann" ), 0 );
+    list.push_back( { 6, "ann", 1.0 } );
+    EXPECT_EQ( by_owner.single( "ann" ).id, 6 );
+    list.revers( );
+    EXPECT_EQ( by_owner.first( "bob" ).id, 5 );
+    list = accounts( );
+    EXPECT_EQ( by_owner.count( "ann" ), 2 );
+
+    // assignments through operator[] need an explicit rebuild
+    list[ 0 ].owner = "zoe";
+    by_owner.rebuild( );
+    EXPECT_EQ( by_owner.single( "zoe" ).id, 1 );
+
+    list.push_back( { 1, "dup", 0.0 } );
+    EXPECT_THROW( by_id.contains( 1 ), std::runtime_error );
+    EXPECT_THROW( list.index_by( &Account::id, true ), std::runtime_error );
+}
+
+TEST( ListSortedIndex, BasicAssertions )
+{
+    auto list = accounts( );
+    auto by_balance = list.sorted_index_by( &Account::balance );
+
+    EXPECT_EQ( by_balance.count( 5.5 ), 2 );
+    EXPECT_EQ( by_balance.first( 5.5 ).id, 2 );
+    EXPECT_EQ( by_balance.where( 5.5 ).select<int>( []( Account a ) { return a.id; } ), List<int>( { 2, 5 } ) );
+    EXPECT_EQ( by_balance.range( 6.0, 11.0 ).select<int>( []( Account a ) { return a.id; } ), List<int>( { 3, 1 } ) );
+    EXPECT_EQ( by_balance.range( 11.0, 6.0 ).size( ), 0 );
+    EXPECT_EQ( by_balance.where_less( 7.0 ).size( ), 2 );
+    EXPECT_EQ( by_balance.where_greater( 7.0 ).select<int>( []( Account a ) { return a.id; } ),
+               List<int>( { 1, 4 } ) );
+    EXPECT_FALSE( by_balance.contains( 1.0 ) );
+    EXPECT_THROW( by_balance.single( 5.5 ), std::runtime_error );
+    EXPECT_EQ( by_balance.single( 12.0 ).owner, "eve" );
+
+    list.take_inplace( 2 );
+    EXPECT_EQ( by_balance.where_greater( 0.0 ).size( ), 2 );
+}
+
+TEST( ListIndexInvalidate, BasicAssertions )
+{
+    auto list = List<int>( { 1, 2, 3 } );
+    auto hashed = list.index_by( []( int i ) { return i; } );
+    auto sorted = list.sorted_index_by( []( int i ) { return i; } );
+    EXPECT_TRUE( hashed.contains( 2 ) );
+    EXPECT_TRUE( sorted.contains( 2 ) );
+
+    // writes through operator[] keep size, buffer and revision, the indexes have to be invalidated
+    list[ 1 ] = 42;
+    hashed.invalidate( );
+    sorted.invalidate( );
+    EXPECT_FALSE( hashed.contains( 2 ) );
+    EXPECT_TRUE( hashed.contains( 42 ) );
+    EXPECT_FALSE( sorted.contains( 2 ) );
+    EXPECT_EQ( sorted.where_greater( 3 ), List<int>( { 42 } ) );
+
+    // std::vector mutators that restore the size are not detected either
+    list.pop_back( );
+    list.push_back( 7 );
+    hashed.invalidate( );
+    sorted.rebuild( );
+    EXPECT_FALSE( hashed.contains( 3 ) );
+    EXPECT_TRUE( hashed.contains( 7 ) );
+    EXPECT_FALSE( sorted.contains( 3 ) );
+    EXPECT_EQ( sorted.range( 5, 10 ), List<int>( { 7 } ) );
+}
+
+TEST( ListIndexAllocator, BasicAssertions )
+{
+    std::byte buffer[ 16 * 1024 ];
+    auto arena = std::pmr::monotonic_buffer_resource( buffer, sizeof( buffer ), std::pmr::null_memory_resource( ) );
+    auto list = pmr::List<int>( { 5, 1, 4, 1, 3 }, &arena );
+
+    auto hashed = list.index_by( []( int i ) { return i; } );
+    auto sorted = list.sorted_index_by( []( int i ) { return i; } );
+    EXPECT_EQ( hashed.count( 1 ), 2 );
+    EXPECT_EQ( hashed.where( 1 ).get_allocator( ).resource( ), &arena );
+    EXPECT_EQ( List<int>( sorted.range( 2, 5 ) ), List<int>( { 3, 4, 5 } ) );
+    EXPECT_EQ( sorted.where_less( 4 ).get_allocator( ).resource( ), &arena );
+    list.push_back( 9 );
+    EXPECT_TRUE( hashed.contains( 9 ) );
+    EXPECT_EQ( sorted.where_greater( 5 ).size( ), 1 );
+}
+
+TEST( ObservableListIndex, BasicAssertions )
+{
+    auto list = ObservableList<Account>( accounts( ) );
+    auto by_owner = HashIndex( list, &Account::owner );
+    auto by_balance = SortedIndex( list, &Account::balance );
+
+    EXPECT_EQ( by_owner.count( "bob" ), 2 );
+    list.push_back( { 6, "bob", 1.0 } );
+    EXPECT_EQ( by_owner.positions( "bob" ), std::vector<size_t>( { 1, 4, 5 } ) );
+    EXPECT_EQ( by_balance.first( 1.0 ).id, 6 );
+    list.pop_back( );
+    EXPECT_EQ( by_owner.count( "bob" ), 2 );
+    EXPECT_FALSE( by_balance.contains( 1.0 ) );
+
+    // changes in the middle are applied by a rebuild on the next lookup
+    list.set( 0, { 1, "bob", 2.0 } );
+    EXPECT_EQ( by_owner.positions( "bob" ), std::vector<size_t>( { 0, 1, 4 } ) );
+    EXPECT_EQ( by_balance.where_less( 5.0 ).size( ), 1 );
+    list.erase( 1 );
+    EXPECT_EQ( by_owner.positions( "bob" ), std::vector<size_t>( { 0, 3 } ) );
+    EXPECT_EQ( by_balance.count( 5.5 ), 1 );
+
+    list.clear( );
+    EXPECT_FALSE( by_owner.contains( "bob" ) );
+    list.push_back( { 7, "amy", 3.0 } );
+    EXPECT_EQ( by_balance.single( 3.0 ).owner, "amy" );
+    EXPECT_EQ( by_owner.single( "amy" ).id, 7 );
+
+    // erase_if compacts the kept elements in order, the indexes follow
+    for ( const auto &a : accounts( ) )
+        list.push_back( a );
+    EXPECT_EQ( list.erase_if( []( const Account &a ) { return a.owner != "bob"; } ), 4 );
+    EXPECT_EQ( list.list( ).select<int>( []( const Account &a ) { return a.id; } ), List<int>( { 2, 5 } ) );
+    EXPECT_EQ( by_owner.positions( "bob" ), std::vector<size_t>( { 0, 1 } ) );
+    EXPECT_FALSE( by_owner.contains( "amy" ) );
+    EXPECT_EQ( by_balance.count( 5.5 ), 2 );
+    EXPECT_EQ( list.erase_if( []( const Account & ) { return false; } ), 0 );
+}
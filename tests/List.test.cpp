@@ -2,6 +2,9 @@
 
 #include <vrock/utils/List.hpp>
 
+#include <cmath>
+#include <limits>
+#include <memory_resource>
 #include <string>
 
 struct Person
@@ -215,6 +218,69 @@ TEST( ListJoin, BasicAssertions )
     EXPECT_EQ( res, exp );
 }
 
+TEST( ListHashJoin, BasicAssertions )
+{
+    auto people =
+        vrock::utils::List<Person>( { { 23, "John" }, { 22, "James" }, { 38, "William" }, { 22, "Amelia" } } );
+    auto ages = vrock::utils::List<std::pair<int, std::string>>( { { 22, "young" }, { 38, "old" }, { 50, "older" } } );
+
+    auto res = people.join( ages, &Person::age, []( const auto &p ) { return p.first; },
+                            []( const Person &p, const auto &a ) { return p.name + ":" + a.second; } );
+    auto exp = vrock::utils::List<std::string>( { "James:young", "William:old", "Amelia:young" } );
+    EXPECT_EQ( res, exp );
+
+    // the build side switches to the smaller list, the result is then ordered like the larger one
+    auto res2 = ages.join( people, []( const auto &p ) { return p.first; }, &Person::age,
+                           []( const auto &a, const Person &p ) { return p.name + ":" + a.second; } );
+    EXPECT_EQ( res2, exp );
+}
+
+TEST( ListMergeJoin, BasicAssertions )
+{
+    auto l1 = vrock::utils::List<int>( { 1, 2, 2, 4, 5 } );
+    auto l2 = vrock::utils::List<int>( { 2, 2, 3, 5, 5 } );
+    auto key = []( int i ) { return i; };
+
+    auto res = l1.merge_join( l2, key, key, []( int a, int b ) { return a * 10 + b; } );
+    auto exp = vrock::utils::List<int>( { 22, 22, 22, 22, 55, 55 } );
+    EXPECT_EQ( res, exp );
+
+    // NaN keys never match, in the hash join as well as in the merge join
+    constexpr auto nan = std::numeric_limits<double>::quiet_NaN( );
+    auto d1 = vrock::utils::List<double>( { 1.0, nan } );
+    auto d2 = vrock::utils::List<double>( { nan, 1.0 } );
+    auto dkey = []( double d ) { return d; };
+    auto pair = []( double a, double b ) { return std::make_pair( a, b ); };
+    auto hashed = d1.join( d2, dkey, dkey, pair );
+    ASSERT_EQ( hashed.size( ), 1 );
+    EXPECT_EQ( hashed[ 0 ], std::make_pair( 1.0, 1.0 ) );
+    auto merged = d1.merge_join( vrock::utils::List<double>( { 1.0, nan, nan } ), dkey, dkey, pair );
+    ASSERT_EQ( merged.size( ), 1 );
+    EXPECT_EQ( merged[ 0 ], std::make_pair( 1.0, 1.0 ) );
+}
+
+TEST( ListOuterJoins, BasicAssertions )
+{
+    auto l1 = vrock::utils::List<int>( { 1, 2, 3 } );
+    auto l2 = vrock::utils::List<int>( { 2, 3, 3, 4 } );
+    auto key = []( int i ) { return i; };
+
+    auto left = l1.left_join( l2, key, key, []( int a, const int *b ) { return b ? a * 10 + *b : -a; } );
+    EXPECT_EQ( left, vrock::utils::List<int>( { -1, 22, 33, 33 } ) );
+
+    auto outer = l1.outer_join( l2, key, key,
+                                []( const int *a, const int *b ) { return ( a ? *a : 0 ) * 10 + ( b ? *b : 0 ); } );
+    EXPECT_EQ( outer, vrock::utils::List<int>( { 10, 22, 33, 33, 4 } ) );
+
+    EXPECT_EQ( l1.semi_join( l2, key, key ), vrock::utils::List<int>( { 2, 3 } ) );
+    EXPECT_EQ( l1.anti_join( l2, key, key ), vrock::utils::List<int>( { 1 } ) );
+
+    auto grouped = l1.group_join( l2, key, key, []( int a, const vrock::utils::List<int> &m ) {
+        return std::make_pair( a, m.size( ) );
+    } );
+    EXPECT_EQ( grouped, ( vrock::utils::List<std::pair<int, size_t>>( { { 1, 0 }, { 2, 1 }, { 3, 2 } } ) ) );
+}
+
 TEST( ListGroupBy, BasicAssertions )
 {
     auto list = vrock::utils::List<Person>(
@@ -232,6 +298,55 @@ TEST( ListGroupBy, BasicAssertions )
     EXPECT_EQ( res[ 38 ], exp[ 38 ] );
 }
 
+TEST( ListUnorderedGroupBy, BasicAssertions )
+{
+    auto list = vrock::utils::List<Person>(
+        { { 23, "John" }, { 22, "James" }, { 38, "William" }, { 22, "Amelia" }, { 38, "Emma" } } );
+
+    auto res = list.unordered_group_by( &Person::age, []( const Person &p ) { return p.name.size( ) > 4; } );
+
+    EXPECT_EQ( res.size( ), 4 );
+    EXPECT_EQ( res[ std::make_tuple( 22, true ) ],
+               vrock::utils::List<Person>( std::vector<Person>( { { 22, "James" }, { 22, "Amelia" } } ) ) );
+    EXPECT_EQ( res[ std::make_tuple( 38, false ) ],
+               vrock::utils::List<Person>( std::vector<Person>( { { 38, "Emma" } } ) ) );
+
+    auto ordered = list.group_by( []( const Person &p ) { return p.age / 10; } );
+    EXPECT_EQ( ordered.begin( )->second.size( ), 3 );
+}
+
+TEST( ListGroupAggregate, BasicAssertions )
+{
+    auto list = vrock::utils::List<Person>(
+        { { 23, "John" }, { 22, "James" }, { 38, "William" }, { 22, "Amelia" }, { 38, "Emma" } } );
+
+    auto names = list.group_aggregate( &Person::age, std::string( ),
+                                       []( const Person &p, std::string s ) { return s + p.name[ 0 ]; } );
+    EXPECT_EQ( names[ 22 ], "JA" );
+    EXPECT_EQ( names[ 38 ], "WE" );
+
+    auto counts = list.group_count( &Person::age );
+    EXPECT_EQ( counts[ 22 ], 2 );
+    EXPECT_EQ( counts[ 23 ], 1 );
+
+    auto by_len = []( const Person &p ) { return p.name.size( ); };
+    auto sums = list.group_sum( by_len, &Person::age );
+    EXPECT_EQ( sums[ 4 ], 61 );
+    EXPECT_EQ( sums[ 5 ], 22 );
+    // the sums are 64 bit like List::sum, so large ints do not overflow
+    constexpr auto max = std::numeric_limits<int>::max( );
+    auto large = vrock::utils::List<int>( { max, max, 1 } );
+    auto large_sums = large.group_sum( []( int v ) { return v > 1; }, []( int v ) { return v; } );
+    static_assert( std::is_same_v<decltype( large_sums )::mapped_type, int64_t> );
+    EXPECT_EQ( large_sums[ true ], int64_t( max ) * 2 );
+    EXPECT_EQ( large_sums[ false ], 1 );
+
+    auto mins = list.group_min( &Person::age, &Person::name );
+    auto maxs = list.group_max( &Person::age, &Person::name );
+    EXPECT_EQ( mins[ 22 ], "Amelia" );
+    EXPECT_EQ( maxs[ 38 ], "William" );
+}
+
 TEST( ListOrderBy, BasicAssertions )
 {
     auto list = vrock::utils::List<int>( { 9, 2, 6, 3, 5, 8, 4, 7, 1 } );
@@ -242,6 +357,59 @@ TEST( ListOrderBy, BasicAssertions )
     EXPECT_EQ( list, exp );
 }
 
+TEST( ListOrderByKey, BasicAssertions )
+{
+    auto list = vrock::utils::List<Person>(
+        { { 23, "John" }, { 22, "James" }, { 38, "William" }, { 22, "Amelia" }, { 38, "Emma" } } );
+    auto copy = list;
+
+    auto by_age = list.order_by( &Person::age ).stable( ).to_list( );
+    EXPECT_EQ( by_age, vrock::utils::List<Person>( { { 22, "James" }, { 22, "Amelia" }, { 23, "John" },
+                                                     { 38, "William" }, { 38, "Emma" } } ) );
+    EXPECT_EQ( list, copy );
+
+    vrock::utils::List<Person> by_name = list.order_by_descending( &Person::age ).then_by( &Person::name );
+    EXPECT_EQ( by_name, vrock::utils::List<Person>( { { 38, "Emma" }, { 38, "William" }, { 23, "John" },
+                                                      { 22, "Amelia" }, { 22, "James" } } ) );
+
+    auto top = list.order_by( []( const Person &p ) { return p.name.size( ); } ).take( 2 );
+    EXPECT_EQ( top, vrock::utils::List<Person>( { { 23, "John" }, { 38, "Emma" } } ) );
+
+    // an Ordering over a temporary List owns it, so it can be executed after the statement
+    auto owned = vrock::utils::List<Person>( copy ).order_by( &Person::age );
+    auto owned_descending =
+        vrock::utils::List<Person>( copy ).order_by_descending( &Person::age ).then_by( &Person::name );
+    EXPECT_EQ( owned.stable( ).to_list( ), by_age );
+    EXPECT_EQ( owned_descending.to_list( ), by_name );
+}
+
+TEST( ListOrderByRadix, BasicAssertions )
+{
+    auto ints = vrock::utils::List<int>( );
+    auto doubles = vrock::utils::List<double>( );
+    for ( int i = 0; i < 1000; i++ )
+    {
+        ints.push_back( ( i * 7919 ) % 1001 - 500 );
+        doubles.push_back( ( i % 3 == 0 ) ? -i * 0.5 : i * 0.25 );
+    }
+    doubles[ 10 ] = std::numeric_limits<double>::quiet_NaN( );
+    doubles[ 20 ] = -0.0;
+    auto id = []( auto v ) { return v; };
+
+    auto exp_ints = ints;
+    std::sort( exp_ints.begin( ), exp_ints.end( ) );
+    EXPECT_EQ( ints.order_by( id ).to_list( ), exp_ints );
+    std::reverse( exp_ints.begin( ), exp_ints.end( ) );
+    EXPECT_EQ( ints.order_by_descending( id ).to_list( ), exp_ints );
+
+    auto sorted = doubles.order_by( id ).to_list( );
+    EXPECT_TRUE( std::isnan( sorted.back( ) ) );
+    sorted.pop_back( );
+    EXPECT_TRUE( std::is_sorted( sorted.begin( ), sorted.end( ) ) );
+    EXPECT_TRUE( std::isnan( doubles.order_by_descending( id ).take( 1 )[ 0 ] ) );
+    EXPECT_EQ( ints.order_by( id ).take( 3 ), vrock::utils::List<int>( { -500, -499, -498 } ) );
+}
+
 TEST( ListDistinct, BasicAssertions )
 {
     auto list = vrock::utils::List<int>( { 1, 1, 2, 2, 2, 3, 4, 4 } );
@@ -278,6 +446,81 @@ TEST( ListExcept, BasicAssertions )
     EXPECT_EQ( list1.except( list2 ), exp );
 }
 
+TEST( ListNumeric, BasicAssertions )
+{
+    auto list = vrock::utils::List<int>( { 4, -2, 9, 7, 1, 3, 8, 6, 5, 2, 0 } );
+
+    EXPECT_EQ( list.sum( ), 43 );
+    EXPECT_EQ( list.min( ), -2 );
+    EXPECT_EQ( list.max( ), 9 );
+    EXPECT_DOUBLE_EQ( list.average( ), 43.0 / 11 );
+    EXPECT_EQ( list.count( []( int i ) { return i % 2 == 0; } ), 6 );
+    EXPECT_EQ( list.where_less( 3 ), vrock::utils::List<int>( { -2, 1, 2, 0 } ) );
+    EXPECT_EQ( list.where_greater( 6 ), vrock::utils::List<int>( { 9, 7, 8 } ) );
+    EXPECT_EQ( list.where_equal( 7 ), vrock::utils::List<int>( { 7 } ) );
+    EXPECT_EQ( list.where_between( 2, 5 ), vrock::utils::List<int>( { 4, 3, 5, 2 } ) );
+    EXPECT_THROW( vrock::utils::List<int>( ).min( ), std::runtime_error );
+
+    auto shorts = vrock::utils::List<short>( { 3, 1, 2 } );
+    EXPECT_EQ( shorts.sum( ), 6 );
+    EXPECT_EQ( shorts.max( ), 3 );
+    EXPECT_EQ( shorts.where_greater( 1 ), vrock::utils::List<short>( { 3, 2 } ) );
+
+    auto people = vrock::utils::List<Person>( { { 23, "John" }, { 22, "James" }, { 38, "William" }, { 22, "Emma" } } );
+    EXPECT_EQ( people.min_by( &Person::age ).name, "James" );
+    EXPECT_EQ( people.max_by( []( const Person &p ) { return p.name.size( ); } ).name, "William" );
+}
+
+TEST( ListNumericNaN, BasicAssertions )
+{
+    const auto nan = std::numeric_limits<double>::quiet_NaN( );
+    auto list = vrock::utils::List<double>( { 2.0, nan, -1.0, 3.0 } );
+
+    // NaN is ordered like in less(): greater than every number
+    EXPECT_EQ( list.min( ), -1.0 );
+    EXPECT_TRUE( std::isnan( list.max( ) ) );
+    EXPECT_EQ( list.where_less( 2.5 ), vrock::utils::List<double>( { 2.0, -1.0 } ) );
+    EXPECT_EQ( list.where_greater( 2.5 ).size( ), 2 );
+    EXPECT_EQ( list.where_less( nan ), vrock::utils::List<double>( { 2.0, -1.0, 3.0 } ) );
+    EXPECT_EQ( list.where_between( -1.0, 2.0 ), vrock::utils::List<double>( { 2.0, -1.0 } ) );
+    EXPECT_TRUE( std::isnan( vrock::utils::List<double>( { nan, nan } ).min( ) ) );
+}
+
+TEST( ListInPlace, BasicAssertions )
+{
+    auto list = vrock::utils::List<int>( { 1, 2, 2, 3, 4, 4, 5, 6 } );
+
+    list.where_inplace( []( int i ) { return i % 2 == 0; } );
+    EXPECT_EQ( list, vrock::utils::List<int>( { 2, 2, 4, 4, 6 } ) );
+    list.distinct_inplace( );
+    EXPECT_EQ( list, vrock::utils::List<int>( { 2, 4, 6 } ) );
+    list.take_inplace( 2 );
+    EXPECT_EQ( list, vrock::utils::List<int>( { 2, 4 } ) );
+}
+
+TEST( ListRvalueChain, BasicAssertions )
+{
+    auto list = vrock::utils::List<int>( { 9, 1, 8, 2, 7, 3, 7, 4 } );
+    const auto *buffer = list.data( );
+
+    // chains on temporaries reuse the buffer of the first List
+    auto res = std::move( list )
+                   .where( []( int i ) { return i > 1; } )
+                   .distinct( )
+                   .order_by( []( int a, int b ) { return a < b; } )
+                   .revers( )
+                   .skip( 1 )
+                   .take( 3 );
+    EXPECT_EQ( res, vrock::utils::List<int>( { 8, 7, 4 } ) );
+    EXPECT_EQ( res.data( ), buffer );
+
+    auto l1 = vrock::utils::List<int>( { 1, 5 } );
+    auto l2 = vrock::utils::List<int>( { 5, 7 } );
+    EXPECT_EQ( l1.union_list( l2 ), vrock::utils::List<int>( { 1, 5, 7 } ) );
+    EXPECT_EQ( l1, vrock::utils::List<int>( { 1, 5 } ) );
+    EXPECT_EQ( vrock::utils::List<int>( ).concat( std::move( l2 ) ), vrock::utils::List<int>( { 5, 7 } ) );
+}
+
 TEST( ListTo, BasicAssertions )
 {
     auto list = vrock::utils::List<int>( { 1, 2, 3, 4, 5, 6, 7, 8, 9 } );
@@ -305,4 +548,51 @@ TEST( ListSelectMany, BasicAssertions )
 
     EXPECT_EQ( vrock::utils::select_many( l1 ), exp );
     EXPECT_EQ( vrock::utils::select_many( l2 ), exp );
-}
\ No newline at end of file
+}
+TEST( ListAllocator, BasicAssertions )
+{
+    // every allocation of the query has to come from the arena, the upstream resource throws
+    std::byte buffer[ 16 * 1024 ];
+    auto arena = std::pmr::monotonic_buffer_resource( buffer, sizeof( buffer ), std::pmr::null_memory_resource( ) );
+
+    auto list = vrock::utils::pmr::List<int>( { 5, 1, 4, 1, 3, 9, 2, 6 }, &arena );
+    auto evens = list.where( []( int i ) { return i % 2 == 0; } );
+    auto names = list.select<std::pmr::string>( []( int i ) { return std::pmr::string( i, 'x' ); } );
+    auto sorted = list.distinct( ).order_by( []( int i ) { return i; } ).to_list( );
+    auto groups = list.group_by( []( int i ) { return i % 3; } );
+    auto joined = list.join(
+        evens, []( int i ) { return i; }, []( int i ) { return i; }, []( int a, int b ) { return a + b; } );
+    auto nested = vrock::utils::pmr::List<vrock::utils::pmr::List<int>>( &arena );
+    nested.push_back( evens );
+    nested.push_back( sorted );
+
+    EXPECT_EQ( evens.get_allocator( ).resource( ), &arena );
+    EXPECT_EQ( names.get_allocator( ).resource( ), &arena );
+    EXPECT_EQ( sorted.get_allocator( ).resource( ), &arena );
+    EXPECT_EQ( groups.begin( )->second.get_allocator( ).resource( ), &arena );
+    EXPECT_EQ( joined.get_allocator( ).resource( ), &arena );
+    EXPECT_EQ( vrock::utils::select_many( nested ).get_allocator( ).resource( ), &arena );
+
+    // conversion between allocators copies the elements
+    EXPECT_EQ( vrock::utils::List<int>( evens ), vrock::utils::List<int>( { 4, 2, 6 } ) );
+    EXPECT_EQ( vrock::utils::List<int>( sorted ), vrock::utils::List<int>( { 1, 2, 3, 4, 5, 6, 9 } ) );
+    EXPECT_EQ( vrock::utils::List<int>( joined ), vrock::utils::List<int>( { 8, 4, 12 } ) );
+    EXPECT_EQ( names[ 2 ], "xxxx" );
+    EXPECT_EQ( groups.size( ), 3 );
+
+    auto copy = vrock::utils::pmr::List<int>( vrock::utils::List<int>( { 1, 2 } ), &arena );
+    EXPECT_EQ( copy.concat( evens ).size( ), 5 );
+    EXPECT_EQ( copy.get_allocator( ).resource( ), &arena );
+
+    // moving between resources copies and may throw, so it must not be noexcept
+    static_assert( std::is_nothrow_move_assignable_v<vrock::utils::List<int>> );
+    static_assert( !std::is_nothrow_move_assignable_v<vrock::utils::pmr::List<int>> );
+    auto small = std::pmr::monotonic_buffer_resource( 64 );
+    auto other = vrock::utils::pmr::List<int>( &small );
+    other = std::move( copy );
+    EXPECT_EQ( vrock::utils::List<int>( other ), vrock::utils::List<int>( { 1, 2, 4, 2, 6 } ) );
+    EXPECT_EQ( other.get_allocator( ).resource( ), &small );
+    auto tiny = std::pmr::monotonic_buffer_resource( std::pmr::null_memory_resource( ) );
+    auto full = vrock::utils::pmr::List<int>( &tiny );
+    EXPECT_THROW( full = std::move( other ), std::bad_alloc );
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <vrock/utils/NumericKernels.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using vrock::utils::kernels::Compare;
+namespace kernels = vrock::utils::kernels;
+
+template <class T> static auto random_values( size_t n, bool with_nan ) -> std::vector<T>
+{
+    auto gen = std::mt19937( 42 );
+    auto dist = std::uniform_int_distribution<int>( -1000, 1000 );
+    auto ret = std::vector<T>( n );
+    for ( auto &v : ret )
+        v = static_cast<T>( dist( gen ) );
+    if constexpr ( std::is_floating_point_v<T> )
+        if ( with_nan )
+            for ( size_t i = 3; i < n; i += 17 )
+                ret[ i ] = std::numeric_limits<T>::quiet_NaN( );
+    return ret;
+}
+
+template <class T> static auto same( T a, T b ) -> bool
+{
+    if constexpr ( std::is_floating_point_v<T> )
+        if ( std::isnan( a ) || std::isnan( b ) )
+            return std::isnan( a ) && std::isnan( b );
+    return a == b;
+}
+
+// the vectorized kernels have to return exactly what the scalar kernels return
+template <class T> static auto check_kernels( bool with_nan ) -> void
+{
+    for ( size_t n : { 1, 7, 8, 33, 1000 } )
+    {
+        auto values = random_values<T>( n, with_nan );
+        const T nan = std::is_floating_point_v<T> ? std::numeric_limits<T>::quiet_NaN( ) : T( );
+        const std::vector<std::tuple<Compare, T, T>> filters = {
+            { Compare::less, 10, 10 },   { Compare::greater, -5, -5 },  { Compare::equal, 7, 7 },
+            { Compare::between, -100, 250 }, { Compare::less, nan, nan }, { Compare::greater, nan, nan } };
+
+        std::vector<std::vector<T>> results[ 2 ];
+        decltype( kernels::sum( values.data( ), n ) ) sums[ 2 ];
+        T mins[ 2 ], maxs[ 2 ];
+        for ( int simd = 0; simd < 2; simd++ )
+        {
+            kernels::set_simd_enabled( simd );
+            sums[ simd ] = kernels::sum( values.data( ), n );
+            mins[ simd ] = kernels::min( values.data( ), n );
+            maxs[ simd ] = kernels::max( values.data( ), n );
+            for ( auto [ op, a, b ] : filters )
+            {
+                auto out = std::vector<T>( n );
+                out.resize( kernels::filter( values.data( ), n, op, a, b, out.data( ) ) );
+                results[ simd ].push_back( out );
+            }
+        }
+        kernels::set_simd_enabled( true );
+
+        if constexpr ( std::is_floating_point_v<T> )
+            EXPECT_TRUE( same( sums[ 0 ], sums[ 1 ] ) || std::abs( sums[ 0 ] - sums[ 1 ] ) < 1e-6 );
+        else
+            EXPECT_EQ( sums[ 0 ], sums[ 1 ] );
+        EXPECT_TRUE( same( mins[ 0 ], mins[ 1 ] ) );
+        EXPECT_TRUE( same( maxs[ 0 ], maxs[ 1 ] ) );
+        for ( size_t f = 0; f < filters.size( ); f++ )
+        {
+            ASSERT_EQ( results[ 0 ][ f ].size( ), results[ 1 ][ f ].size( ) );
+            for ( size_t i = 0; i < results[ 0 ][ f ].size( ); i++ )
+                EXPECT_TRUE( same( results[ 0 ][ f ][ i ], results[ 1 ][ f ][ i ] ) );
+        }
+    }
+}
+
+TEST( NumericKernelsDispatch, BasicAssertions )
+{
+    check_kernels<int32_t>( false );
+    check_kernels<int64_t>( false );
+    check_kernels<float>( false );
+    check_kernels<double>( false );
+    check_kernels<float>( true );
+    check_kernels<double>( true );
+}
+
+TEST( NumericKernelsFilterInPlace, BasicAssertions )
+{
+    auto values = std::vector<int32_t>( { 5, 1, 9, 3, 7, 2, 8, 4, 6, 0, 11 } );
+    values.resize( kernels::filter( values.data( ), values.size( ), Compare::greater, 4, 4, values.data( ) ) );
+    EXPECT_EQ( values, std::vector<int32_t>( { 5, 9, 7, 8, 6, 11 } ) );
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <vrock/utils/SegmentedList.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+using vrock::utils::List;
+using vrock::utils::SegmentedList;
+
+TEST( SegmentedListAppend, BasicAssertions )
+{
+    auto list = SegmentedList<int>( 4 );
+    auto addresses = std::vector<const int *>( );
+    for ( int i = 0; i < 10; i++ )
+        addresses.push_back( &list.push_back( i ) );
+
+    EXPECT_EQ( list.size( ), 10 );
+    EXPECT_EQ( list.chunk_count( ), 3 );
+    EXPECT_EQ( list.chunk( 2 ).size( ), 2 );
+    for ( int i = 0; i < 1000; i++ )
+        list.push_back( i );
+    // growing never moves existing elements
+    for ( size_t i = 0; i < addresses.size( ); i++ )
+        EXPECT_EQ( &list[ i ], addresses[ i ] );
+
+    EXPECT_EQ( list[ 9 ], 9 );
+    EXPECT_EQ( list[ 10 ], 0 );
+    EXPECT_THROW( list.at( 1010 ), std::out_of_range );
+    EXPECT_EQ( std::distance( list.begin( ), list.end( ) ), 1010 );
+
+    for ( int i = 0; i < 1000; i++ )
+        list.pop_back( );
+    EXPECT_EQ( list.to_list( ), List<int>( { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 } ) );
+    EXPECT_EQ( list.chunk_count( ), 3 );
+}
+
+TEST( SegmentedListQuery, BasicAssertions )
+{
+    auto list = SegmentedList<int>( List<int>( { 5, 1, 4, 1, 3, 9, 2, 6 } ), 3 );
+
+    EXPECT_EQ( list.where( []( int i ) { return i % 2 == 1; } ).to_list( ), List<int>( { 5, 1, 1, 3, 9 } ) );
+    EXPECT_EQ( list.select( []( int i ) { return std::to_string( i ); } ).to_list( ).front( ), "5" );
+    EXPECT_EQ( list.aggregate<int>( []( int i, int s ) { return i + s; } ), 31 );
+    EXPECT_EQ( list.count( []( int i ) { return i == 1; } ), 2 );
+    EXPECT_EQ( list.first( []( int i ) { return i > 4; } ), 5 );
+    EXPECT_EQ( list.last( []( int i ) { return i > 4; } ), 6 );
+    EXPECT_EQ( list.first_or_default( []( int i ) { return i > 10; }, -1 ), -1 );
+    EXPECT_THROW( list.last( []( int i ) { return i > 10; } ), std::runtime_error );
+    EXPECT_TRUE( list.contains( 9 ) );
+    EXPECT_TRUE( list.any( []( int i ) { return i > 8; } ) );
+    EXPECT_FALSE( list.all( []( int i ) { return i > 1; } ) );
+    EXPECT_EQ( list.skip( 5 ).to_list( ), List<int>( { 9, 2, 6 } ) );
+    EXPECT_EQ( list.take( 2 ).to_list( ), List<int>( { 5, 1 } ) );
+    EXPECT_EQ( list.group_by( []( int i ) { return i % 3; } ).at( 0 ), List<int>( { 3, 9, 6 } ) );
+}
+
+TEST( SegmentedListSplice, BasicAssertions )
+{
+    auto a = SegmentedList<int>( List<int>( { 1, 2, 3, 4, 5 } ), 4 );
+    auto b = SegmentedList<int>( List<int>( { 6, 7 } ), 4 );
+    const int *six = &b[ 0 ];
+
+    a.concat( std::move( b ) );
+    EXPECT_TRUE( b.empty( ) );
+    EXPECT_EQ( &a[ 5 ], six );
+    EXPECT_EQ( a[ 4 ], 5 );
+    EXPECT_EQ( a[ 6 ], 7 );
+    a.push_back( 8 );
+    a.push_back( 9 );
+    a.push_back( 10 );
+    EXPECT_EQ( a.to_list( ), List<int>( { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 } ) );
+    EXPECT_EQ( a[ 9 ], 10 );
+
+    auto lists = SegmentedList<SegmentedList<int>>( 2 );
+    for ( int i = 0; i < 5; i++ )
+        lists.push_back( SegmentedList<int>( List<int>( { i * 3, i * 3 + 1, i * 3 + 2 } ), 2 ) );
+    const int *first = &lists[ 0 ][ 0 ];
+    auto flat = vrock::utils::select_many( std::move( lists ) );
+    EXPECT_EQ( flat.size( ), 15 );
+    EXPECT_EQ( &flat[ 0 ], first );
+    for ( size_t i = 0; i < flat.size( ); i++ )
+        EXPECT_EQ( flat[ i ], static_cast<int>( i ) );
+}
+
+TEST( SegmentedListParallel, BasicAssertions )
+{
+    auto list = SegmentedList<long>( 64 );
+    for ( long i = 0; i < 10000; i++ )
+        list.push_back( i );
+
+    list.parallel_for_each( []( long &e ) { e *= 2; }, 4 );
+    auto sum = std::atomic<long>( 0 );
+    list.parallel_for_each_chunk(
+        [ & ]( std::span<long> c, size_t first ) {
+            EXPECT_EQ( c[ 0 ], static_cast<long>( first ) * 2 );
+            long s = 0;
+            for ( auto e : c )
+                s += e;
+            sum += s;
+        },
+        4 );
+    EXPECT_EQ( sum, 9999L * 10000L );
+
+    EXPECT_THROW( list.parallel_for_each_chunk(
+                      []( std::span<long> c, size_t ) {
+                          if ( c[ 0 ] == 640 )
+                              throw std::runtime_error( "failed" );
+                      },
+                      4 ),
+                  std::runtime_error );
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <vrock/utils/Serialize.hpp>
+
+#include <cstring>
+#include <string>
+
+using namespace vrock::utils;
+
+struct Reading
+{
+    int sensor{ };
+    double value{ };
+    char unit{ };
+
+    friend bool operator==( const Reading &lhs, const Reading &rhs )
+    {
+        return lhs.sensor == rhs.sensor && lhs.value == rhs.value && lhs.unit == rhs.unit;
+    }
+};
+
+struct Customer
+{
+    int id{ };
+    std::string name;
+    double score{ };
+    std::string note;
+
+    friend bool operator==( const Customer &lhs, const Customer &rhs )
+    {
+        return lhs.id == rhs.id && lhs.name == rhs.name && lhs.score == rhs.score && lhs.note == rhs.note;
+    }
+};
+
+TEST( SerializeRaw, BasicAssertions )
+{
+    EXPECT_EQ( crc32( reinterpret_cast<const uint8_t *>( "123456789" ), 9 ), 0xcbf43926u );
+
+    auto list = List<Reading>( { { 1, 2.5, 'c' }, { 2, -1.0, 'k' }, { 3, 0.0, 'f' } } );
+    auto bytes = to_bytes( list );
+    EXPECT_EQ( bytes->length, 32 + 3 * sizeof( Reading ) );
+    EXPECT_EQ( from_bytes<Reading>( *bytes ), list );
+
+    auto view = view_as<Reading>( *bytes );
+    ASSERT_EQ( view.size( ), 3 );
+    EXPECT_EQ( view[ 1 ], list[ 1 ] );
+    EXPECT_EQ( static_cast<const void *>( view.data( ) ), bytes->data + 32 );
+
+    EXPECT_TRUE( from_bytes<int>( *to_bytes( List<int>( ) ) ).empty( ) );
+    EXPECT_THROW( from_bytes<int>( *bytes ), std::runtime_error );
+    // same size, but a different kind of type
+    auto ints = to_bytes( List<int32_t>( { 1, 2, 3 } ) );
+    EXPECT_THROW( view_as<float>( *ints ), std::runtime_error );
+    EXPECT_THROW( from_bytes<uint32_t>( *ints ), std::runtime_error );
+    EXPECT_THROW( view_as<double>( *to_bytes( List<int64_t>( { 1 } ) ) ), std::runtime_error );
+    EXPECT_EQ( from_bytes<int32_t>( *ints ), List<int32_t>( { 1, 2, 3 } ) );
+    EXPECT_THROW( from_bytes<Reading>( *bytes->subarr( 0, 40 ) ), std::runtime_error );
+    EXPECT_THROW( from_bytes<Reading>( *bytes->subarr( 0, 16 ) ), std::runtime_error );
+
+    bytes->data[ 40 ] ^= 1;
+    EXPECT_THROW( view_as<Reading>( *bytes ), std::runtime_error );
+    EXPECT_NO_THROW( view_as<Reading>( *bytes, false ) );
+    bytes->data[ 40 ] ^= 1;
+    bytes->data[ 16 ] ^= 1; // element count is covered by the checksum as well
+    EXPECT_THROW( from_bytes<Reading>( *bytes ), std::runtime_error );
+
+    // a forged count whose size wraps around to the payload size must be rejected without the checksum
+    auto empty = to_bytes( List<int>( ) );
+    auto forged = uint64_t( 1 ) << 62;
+    std::memcpy( empty->data + 16, &forged, sizeof( forged ) );
+    EXPECT_THROW( view_as<int>( *empty, false ), std::runtime_error );
+}
+
+TEST( SerializeSchema, BasicAssertions )
+{
+    auto list = List<Customer>( { { 1, "ann", 2.5, "" },
+                                  { 2, std::string( 300, 'x' ), -1.0, "long name" },
+                                  { 3, "", 0.0, "no name" } } );
+    auto s = schema( &Customer::id, &Customer::name, &Customer::score, &Customer::note );
+
+    auto rows = s.to_bytes( list );
+    auto columns = s.to_bytes( list, Layout::columns );
+    // ids, scores, a two byte varint for the 300 characters and one byte varints for the other strings
+    auto payload = 3 * ( sizeof( int ) + sizeof( double ) ) + 2 + 300 + 5 + 3 + 0 + 9 + 7;
+    EXPECT_EQ( rows->length, 32 + payload );
+    EXPECT_EQ( columns->length, rows->length );
+    EXPECT_NE( rows->to_string( ), columns->to_string( ) );
+    EXPECT_EQ( s.from_bytes( *rows ), list );
+    EXPECT_EQ( s.from_bytes( *columns ), list );
+
+    // members not in the schema keep their default value
+    auto ids = schema( &Customer::id, &Customer::score );
+    auto partial = ids.from_bytes( *ids.to_bytes( list ) );
+    EXPECT_EQ( partial[ 1 ].id, 2 );
+    EXPECT_EQ( partial[ 1 ].name, "" );
+
+    EXPECT_THROW( ids.from_bytes( *rows ), std::runtime_error );
+    EXPECT_THROW( s.from_bytes( *to_bytes( List<int>( { 1, 2 } ) ) ), std::runtime_error );
+    EXPECT_THROW( s.from_bytes( *rows->subarr( 0, rows->length - 1 ) ), std::runtime_error );
+    EXPECT_THROW( s.to_bytes( list, Layout::raw ), std::invalid_argument );
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <vrock/utils/List.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string>
+
+using namespace vrock::utils;
+
+struct Visit
+{
+    int page{ };
+    std::string user;
+};
+
+TEST( SketchHyperLogLog, BasicAssertions )
+{
+    auto sketch = HyperLogLog<uint64_t>( );
+    auto parts = std::vector<HyperLogLog<uint64_t>>( 4 );
+    uint64_t n = 0;
+    for ( uint64_t target : { 10, 100, 1000, 10000, 100000, 400000 } )
+    {
+        for ( ; n < target; n++ )
+        {
+            sketch.add( n );
+            sketch.add( n ); // duplicates do not change the estimate
+            parts[ n % 4 ].add( n );
+        }
+        auto error = std::abs( sketch.estimate( ) - static_cast<double>( n ) ) / static_cast<double>( n );
+        EXPECT_LE( error, 3 * sketch.standard_error( ) ) << n;
+    }
+
+    // merging keeps the maximum of every register, so the merged sketch equals the one over all keys
+    auto merged = HyperLogLog<uint64_t>( );
+    for ( const auto &p : parts )
+        merged.merge( p );
+    EXPECT_EQ( merged.estimate( ), sketch.estimate( ) );
+    EXPECT_EQ( HyperLogLog<int>( ).estimate( ), 0.0 );
+    EXPECT_THROW( merged.merge( HyperLogLog<uint64_t>( 10 ) ), std::invalid_argument );
+    EXPECT_THROW( HyperLogLog<int>( 3 ), std::invalid_argument );
+
+    auto visits = List<Visit>( );
+    for ( int i = 0; i < 20000; i++ )
+        visits.push_back( { i % 97, "user-" + std::to_string( i % 5000 ) } );
+    EXPECT_NEAR( visits.approx_count_distinct( &Visit::user ), 5000, 5000 * 3 * 0.0082 );
+    EXPECT_NEAR( visits.select<int>( []( const Visit &v ) { return v.page; } ).approx_count_distinct( ), 97, 3 );
+}
+
+TEST( SketchQuantile, BasicAssertions )
+{
+    constexpr int n = 100000;
+    auto values = List<int>( );
+    values.resize( n );
+    std::iota( values.begin( ), values.end( ), 0 );
+    std::shuffle( values.begin( ), values.end( ), std::mt19937( 7 ) );
+
+    auto sketch = QuantileSketch<int>( );
+    auto parts = std::vector<QuantileSketch<int>>( 8 );
+    for ( int i = 0; i < n; i++ )
+    {
+        sketch.add( values[ i ] );
+        parts[ i % 8 ].add( values[ i ] );
+    }
+    auto merged = QuantileSketch<int>( );
+    for ( const auto &p : parts )
+        merged.merge( p );
+
+    EXPECT_EQ( sketch.count( ), n );
+    EXPECT_EQ( merged.count( ), n );
+    EXPECT_LT( sketch.retained_count( ), 1000 );
+    EXPECT_LT( merged.retained_count( ), 1000 );
+    EXPECT_EQ( sketch.quantile( 0.0 ), 0 );
+    EXPECT_EQ( sketch.quantile( 1.0 ), n - 1 );
+    for ( double q = 0.01; q < 1.0; q += 0.01 )
+    {
+        // the values are 0 .. n - 1, so the rank of a value is value / n
+        EXPECT_LE( std::abs( sketch.quantile( q ) / double( n ) - q ), sketch.rank_error( ) ) << q;
+        EXPECT_LE( std::abs( merged.quantile( q ) / double( n ) - q ), merged.rank_error( ) ) << q;
+        EXPECT_LE( std::abs( sketch.rank( static_cast<int>( q * n ) ) - q ), sketch.rank_error( ) ) << q;
+    }
+    EXPECT_NEAR( values.approx_quantile( 0.5 ), n / 2, n * 0.0133 );
+    EXPECT_THROW( QuantileSketch<int>( ).quantile( 0.5 ), std::runtime_error );
+    EXPECT_THROW( List<int>( ).approx_quantile( 0.5 ), std::runtime_error );
+}
+
+TEST( SketchSpaceSaving, BasicAssertions )
+{
+    // zipf like stream: key i occurs about 20000 / i times
+    auto stream = List<int>( );
+    auto exact = std::map<int, uint64_t>( );
+    for ( int i = 1; i <= 2000; i++ )
+        for ( int j = 0; j < 20000 / i; j++ )
+        {
+            stream.push_back( i );
+            exact[ i ]++;
+        }
+    std::shuffle( stream.begin( ), stream.end( ), std::mt19937( 3 ) );
+
+    auto sketch = SpaceSaving<int>( 100 );
+    auto parts = std::vector<SpaceSaving<int>>( 4, SpaceSaving<int>( 100 ) );
+    for ( size_t i = 0; i < stream.size( ); i++ )
+    {
+        sketch.add( stream[ i ] );
+        parts[ i % 4 ].add( stream[ i ] );
+    }
+    auto merged = SpaceSaving<int>( 100 );
+    for ( const auto &p : parts )
+        merged.merge( p );
+
+    for ( const auto *s : { &sketch, &merged } )
+    {
+        EXPECT_EQ( s->count( ), stream.size( ) );
+        auto top = s->top( 100 );
+        for ( const auto &f : top )
+        {
+            EXPECT_GE( f.count, exact[ f.key ] );
+            EXPECT_LE( f.count - f.error, exact[ f.key ] );
+            EXPECT_LE( f.count - exact[ f.key ], s->max_error( ) );
+        }
+        // every key occurring more than n / capacity times is reported
+        for ( const auto &[ key, count ] : exact )
+        {
+            if ( count > s->max_error( ) )
+            {
+                EXPECT_TRUE( top.any( [ key ]( const Frequent<int> &f ) { return f.key == key; } ) ) << key;
+            }
+        }
+        auto keys = s->top( 3 ).select<int>( []( const Frequent<int> &f ) { return f.key; } );
+        EXPECT_EQ( keys, List<int>( { 1, 2, 3 } ) );
+    }
+
+    auto visits = List<Visit>( { { 1, "ann" }, { 2, "bob" }, { 1, "eve" }, { 3, "ann" }, { 1, "bob" } } );
+    auto pages = visits.top_frequent( 2, &Visit::page );
+    ASSERT_EQ( pages.size( ), 2 );
+    EXPECT_EQ( pages[ 0 ].key, 1 );
+    EXPECT_EQ( pages[ 0 ].count, 3 );
+    EXPECT_EQ( List<int>( { 4, 4, 2 } ).top_frequent( 5 ).size( ), 2 );
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <vrock/utils/List.hpp>
+#include <vrock/utils/Trace.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace vrock::utils;
+
+TEST( TraceSinks, BasicAssertions )
+{
+    auto ring = std::make_shared<trace::RingSink>( 3 );
+    trace::set_sink( ring );
+    EXPECT_TRUE( trace::enabled( ) );
+    for ( size_t i = 0; i < 5; i++ )
+    {
+        auto scope = trace::Scope( "op", i );
+        scope.result( std::vector<int>( i ) );
+    }
+    auto events = ring->events( );
+    ASSERT_EQ( events.size( ), 3 );
+    EXPECT_EQ( ring->dropped( ), 2 );
+    EXPECT_EQ( events[ 0 ].input, 2 );
+    EXPECT_EQ( events[ 2 ].input, 4 );
+    EXPECT_EQ( events[ 2 ].output, 4 );
+    EXPECT_EQ( std::string( events[ 2 ].op ), "op" );
+    EXPECT_GE( events[ 2 ].duration_ns, 0 );
+    EXPECT_GE( events[ 2 ].bytes, 4 * sizeof( int ) );
+
+    size_t calls = 0;
+    trace::set_sink( std::make_shared<trace::CallbackSink>( [ & ]( const trace::Event &e ) {
+        calls++;
+        EXPECT_EQ( e.input, 7 );
+    } ) );
+    trace::emit( { "callback", 7 } );
+    EXPECT_EQ( calls, 1 );
+
+    trace::set_sink( nullptr );
+    EXPECT_FALSE( trace::enabled( ) );
+    {
+        auto scope = trace::Scope( "disabled", 1 );
+    }
+    EXPECT_EQ( calls, 1 );
+
+    auto path = std::string( "vrockutils_trace_test.json" );
+    {
+        auto chrome = trace::ChromeTraceSink( path );
+        chrome.record( { "List::where", 10, 4, 1000, 2000, 64, 1 } );
+        chrome.record( { "List::select", 4, 4, 3000, 500, 32, 1 } );
+    }
+    auto in = std::ifstream( path );
+    auto buffer = std::stringstream( );
+    buffer << in.rdbuf( );
+    auto json = buffer.str( );
+    in.close( );
+    std::remove( path.c_str( ) );
+    EXPECT_NE( json.find( "\"traceEvents\"" ), std::string::npos );
+    EXPECT_NE( json.find( "\"name\":\"List::where\"" ), std::string::npos );
+    EXPECT_NE( json.find( "\"ts\":1.000,\"dur\":2.000" ), std::string::npos );
+    EXPECT_NE( json.find( "\"input\":4,\"output\":4,\"bytes\":32}}\n]}" ), std::string::npos );
+}
+
+#ifdef VROCKUTILS_TRACE
+TEST( TraceList, BasicAssertions )
+{
+    auto ring = std::make_shared<trace::RingSink>( );
+    trace::set_sink( ring );
+
+    auto list = List<int>( { 5, 1, 4, 1, 3, 2 } );
+    auto res = list.where( []( int i ) { return i > 1; } ).select<int>( []( int i ) { return i * 2; } );
+    auto groups = list.group_by( []( int i ) { return i % 2; } );
+    trace::set_sink( nullptr );
+
+    auto events = ring->events( );
+    ASSERT_EQ( events.size( ), 3 );
+    EXPECT_EQ( std::string( events[ 0 ].op ), "List::where" );
+    EXPECT_EQ( events[ 0 ].input, 6 );
+    EXPECT_EQ( events[ 0 ].output, 4 );
+    EXPECT_EQ( std::string( events[ 1 ].op ), "List::select" );
+    EXPECT_EQ( events[ 1 ].input, 4 );
+    EXPECT_EQ( events[ 1 ].output, res.size( ) );
+    EXPECT_EQ( std::string( events[ 2 ].op ), "List::group_by" );
+    EXPECT_EQ( events[ 2 ].output, groups.size( ) );
+}
+#endif
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <vrock/utils/Views.hpp>
+
+#include <algorithm>
+#include <string>
+
+using namespace vrock::utils;
+
+struct Sale
+{
+    std::string region;
+    int amount{ };
+};
+
+TEST( ObservableListNotify, BasicAssertions )
+{
+    auto sales = ObservableList<Sale>( List<Sale>( { { "north", 5 }, { "south", 3 } } ) );
+    auto total = RunningTotalView( sales, &Sale::amount );
+    EXPECT_EQ( total.total( ), 8 );
+    EXPECT_EQ( total.count( ), 2 );
+
+    sales.push_back( { "north", 2 } );
+    sales.insert( 0, { "east", 10 } );
+    EXPECT_EQ( total.total( ), 20 );
+    sales.set( 1, { "north", 1 } );
+    EXPECT_EQ( total.total( ), 16 );
+    sales.erase( 0 );
+    EXPECT_EQ( total.total( ), 6 );
+    EXPECT_EQ( sales.count( ), 3 );
+    EXPECT_DOUBLE_EQ( total.average( ), 2.0 );
+
+    EXPECT_EQ( sales.erase_if( []( const Sale &s ) { return s.region == "north"; } ), 2 );
+    EXPECT_EQ( total.total( ), 3 );
+    sales.clear( );
+    EXPECT_EQ( total.count( ), 0 );
+    EXPECT_THROW( total.average( ), std::runtime_error );
+
+    {
+        auto scoped = RunningTotalView( sales, &Sale::amount );
+        sales.push_back( { "west", 4 } );
+        EXPECT_EQ( scoped.total( ), 4 );
+    }
+    sales.push_back( { "west", 1 } );
+    EXPECT_EQ( total.total( ), 5 );
+
+    auto other = ObservableList<Sale>( );
+    EXPECT_THROW( other.subscribe( total ), std::logic_error );
+    sales.unsubscribe( total );
+    sales.push_back( { "west", 1 } );
+    EXPECT_EQ( total.total( ), 5 );
+}
+
+TEST( ViewsPerKey, BasicAssertions )
+{
+    auto sales = ObservableList<Sale>( );
+    auto counts = CountView( sales, &Sale::region );
+    auto sums = SumView( sales, &Sale::region, &Sale::amount );
+    auto smallest = MinView( sales, &Sale::region, &Sale::amount );
+    auto largest = MaxView( sales, &Sale::region, &Sale::amount );
+    auto regions = DistinctCountView( sales, []( const Sale &s ) { return s.region; } );
+
+    sales.append( List<Sale>( { { "north", 5 }, { "south", 3 }, { "north", 9 }, { "north", 1 } } ) );
+    EXPECT_EQ( counts.count( "north" ), 3 );
+    EXPECT_EQ( sums.sum( "north" ), 15 );
+    EXPECT_EQ( smallest.get( "north" ), 1 );
+    EXPECT_EQ( largest.get( "north" ), 9 );
+    EXPECT_EQ( regions.count( ), 2 );
+
+    // erasing the current extreme falls back to the next value
+    sales.erase( 2 );
+    EXPECT_EQ( largest.get( "north" ), 5 );
+    sales.erase( 2 );
+    EXPECT_EQ( smallest.get( "north" ), 5 );
+    EXPECT_EQ( sums.sum( "north" ), 5 );
+    EXPECT_EQ( sums.groups( ).at( "north" ).count, 1 );
+
+    sales.erase( 1 );
+    EXPECT_EQ( counts.count( "south" ), 0 );
+    EXPECT_EQ( counts.groups( ).size( ), 1 );
+    EXPECT_FALSE( regions.contains( "south" ) );
+    EXPECT_FALSE( largest.contains( "south" ) );
+    EXPECT_THROW( smallest.get( "south" ), std::out_of_range );
+
+    // views created later start from the current contents
+    auto late = CountView( sales, &Sale::region );
+    EXPECT_EQ( late.count( "north" ), 1 );
+
+    // the views agree with recomputing from scratch
+    for ( int i = 0; i < 200; i++ )
+        sales.push_back( { std::to_string( i % 7 ), i % 13 } );
+    sales.erase_if( []( const Sale &s ) { return s.amount % 3 == 0; } );
+    auto expected = sales.list( ).group_by( &Sale::region );
+    EXPECT_EQ( counts.groups( ).size( ), expected.size( ) );
+    for ( const auto &[ key, group ] : expected )
+    {
+        const auto &region = std::get<0>( key );
+        EXPECT_EQ( counts.count( region ), group.size( ) );
+        EXPECT_EQ( sums.sum( region ), group.select<int>( []( const Sale &s ) { return s.amount; } ).sum( ) );
+        EXPECT_EQ( smallest.get( region ), group.min_by( &Sale::amount ).amount );
+        EXPECT_EQ( largest.get( region ), group.max_by( &Sale::amount ).amount );
+    }
+}
+
+TEST( AggregateView, BasicAssertions )
+{
+    auto sales = ObservableList<Sale>( List<Sale>( { { "north", 5 }, { "south", 3 }, { "north", 9 } } ) );
+    auto product = AggregateView(
+        sales, &Sale::region, 1, []( const Sale &s, int acc ) { return acc * s.amount; },
+        []( const Sale &s, int acc ) { return acc / s.amount; } );
+    auto longest = AggregateView( sales, &Sale::region, std::string( ),
+                                  []( const Sale &s, std::string acc ) { return acc + std::to_string( s.amount ); } );
+    EXPECT_EQ( product.get( "north" ), 45 );
+    EXPECT_EQ( longest.get( "north" ), "59" );
+
+    sales.erase( 0 );
+    EXPECT_EQ( product.get( "north" ), 9 );
+    EXPECT_EQ( longest.get( "north" ), "9" );
+    sales.push_back( { "north", 2 } );
+    EXPECT_EQ( product.get( "north" ), 18 );
+    EXPECT_EQ( longest.get( "north" ), "92" );
+    sales.erase( 1 );
+    EXPECT_EQ( longest.get( "north" ), "2" );
+    sales.clear( );
+    EXPECT_EQ( product.get( "north" ), 1 );
+    EXPECT_EQ( longest.get( "south" ), "" );
+
+    // erase_if removes several elements at once, the recomputed groups must skip all of them
+    auto amounts = ObservableList<Sale>( List<Sale>(
+        { { "north", 1 }, { "north", 5 }, { "north", 3 }, { "north", 7 }, { "north", 2 }, { "east", 6 } } ) );
+    auto largest = AggregateView( amounts, &Sale::region, 0,
+                                  []( const Sale &s, int acc ) { return std::max( acc, s.amount ); } );
+    auto smallest = AggregateView( amounts, &Sale::region, 100,
+                                   []( const Sale &s, int acc ) { return std::min( acc, s.amount ); } );
+    EXPECT_EQ( largest.get( "north" ), 7 );
+    EXPECT_EQ( amounts.erase_if( []( const Sale &s ) { return s.amount >= 5; } ), 3 );
+    EXPECT_EQ( largest.get( "north" ), 3 );
+    EXPECT_EQ( largest.get( "east" ), 0 );
+    EXPECT_EQ( smallest.get( "north" ), 1 );
+    amounts.erase_if( []( const Sale &s ) { return s.amount < 3; } );
+    EXPECT_EQ( smallest.get( "north" ), 3 );
+    EXPECT_EQ( largest.get( "north" ), 3 );
+}
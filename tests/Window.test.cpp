@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <vrock/utils/List.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+
+using namespace vrock::utils;
+
+struct Tick
+{
+    int64_t time{ };
+    double price{ };
+};
+
+TEST( ListChunkWindow, BasicAssertions )
+{
+    auto list = List<int>( { 1, 2, 3, 4, 5, 6, 7, 8 } );
+
+    auto chunks = list.chunk( 3 );
+    ASSERT_EQ( chunks.size( ), 3 );
+    EXPECT_EQ( chunks[ 0 ].data( ), list.data( ) );
+    EXPECT_EQ( chunks[ 2 ].size( ), 2 );
+    auto copies = chunks.to_list( );
+    ASSERT_EQ( copies.size( ), 3 );
+    EXPECT_EQ( copies[ 1 ], List<int>( { 4, 5, 6 } ) );
+    EXPECT_EQ( copies[ 2 ], List<int>( { 7, 8 } ) );
+    EXPECT_THROW( chunks.at( 3 ), std::out_of_range );
+
+    auto windows = list.window( 3, 2 );
+    ASSERT_EQ( windows.size( ), 3 );
+    EXPECT_EQ( windows[ 2 ].front( ), 5 );
+    auto sums = windows.select(
+        []( std::span<const int> w ) { return std::accumulate( w.begin( ), w.end( ), 0 ); } );
+    EXPECT_EQ( sums, List<int>( { 6, 12, 18 } ) );
+    size_t count = 0;
+    for ( auto w : list.window( 4 ) )
+        count += w.size( ) == 4;
+    EXPECT_EQ( count, 5 );
+
+    EXPECT_TRUE( list.window( 9 ).empty( ) );
+    EXPECT_TRUE( List<int>( ).chunk( 2 ).empty( ) );
+    EXPECT_THROW( list.chunk( 0 ), std::invalid_argument );
+    EXPECT_THROW( list.window( 2, 0 ), std::invalid_argument );
+}
+
+TEST( ListSlidingAggregates, BasicAssertions )
+{
+    auto rng = std::mt19937( 11 );
+    auto dist = std::uniform_real_distribution<double>( -1e6, 1e6 );
+    auto values = List<double>( );
+    for ( int i = 0; i < 5000; i++ )
+        values.push_back( dist( rng ) );
+
+    for ( size_t w : { 1, 7, 64 } )
+        for ( size_t step : { 1, 3 } )
+        {
+            auto sums = values.sliding_sum( w, step );
+            auto means = values.sliding_mean( w, step );
+            auto mins = values.sliding_min( w, step );
+            auto maxs = values.sliding_max( w, step );
+            auto windows = values.window( w, step );
+            ASSERT_EQ( sums.size( ), windows.size( ) );
+            ASSERT_EQ( mins.size( ), windows.size( ) );
+            for ( size_t i = 0; i < windows.size( ); i++ )
+            {
+                auto window = List<double>( windows[ i ].begin( ), windows[ i ].end( ) );
+                EXPECT_NEAR( sums[ i ], window.sum( ), 1e-6 );
+                EXPECT_NEAR( means[ i ], window.average( ), 1e-6 );
+                EXPECT_EQ( mins[ i ], window.min( ) );
+                EXPECT_EQ( maxs[ i ], window.max( ) );
+            }
+        }
+
+    auto ints = List<int>( { 3, 1, 4, 1, 5, 9, 2, 6 } );
+    EXPECT_EQ( ints.sliding_sum( 3 ), List<int64_t>( { 8, 6, 10, 15, 16, 17 } ) );
+    EXPECT_EQ( ints.sliding_min( 3 ), List<int>( { 1, 1, 1, 1, 2, 2 } ) );
+    EXPECT_EQ( ints.sliding_max( 3, 2 ), List<int>( { 4, 5, 9 } ) );
+    EXPECT_EQ( ints.sliding_mean( 4, 4 ), List<double>( { 2.25, 5.5 } ) );
+    EXPECT_TRUE( ints.sliding_sum( 9 ).empty( ) );
+    EXPECT_THROW( ints.sliding_max( 0 ), std::invalid_argument );
+
+    // NaN behaves like in min and max: it is the largest value
+    auto nan = std::numeric_limits<double>::quiet_NaN( );
+    auto with_nan = List<double>( { 1.0, nan, 2.0, 3.0 } );
+    EXPECT_EQ( with_nan.sliding_min( 2 ), List<double>( { 1.0, 2.0, 2.0 } ) );
+    EXPECT_TRUE( std::isnan( with_nan.sliding_max( 2 )[ 1 ] ) );
+    EXPECT_EQ( with_nan.sliding_max( 2 )[ 2 ], 3.0 );
+
+    // NaN and infinities only affect the sums and means of the windows containing them
+    auto inf = std::numeric_limits<double>::infinity( );
+    auto nan_sums = List<double>( { 1.0, nan, 1.0, 1.0, 1.0, 1.0 } ).sliding_sum( 2 );
+    ASSERT_EQ( nan_sums.size( ), 5 );
+    EXPECT_TRUE( std::isnan( nan_sums[ 0 ] ) );
+    EXPECT_TRUE( std::isnan( nan_sums[ 1 ] ) );
+    EXPECT_EQ( nan_sums.skip( 2 ), List<double>( { 2.0, 2.0, 2.0 } ) );
+    auto inf_sums = List<double>( { 1.0, inf, 1.0, 1.0, -inf, 1.0, 1.0 } ).sliding_sum( 2 );
+    EXPECT_EQ( inf_sums, List<double>( { inf, inf, 2.0, -inf, -inf, 2.0 } ) );
+    auto mixed = List<double>( { inf, -inf, 3.0, 5.0 } ).sliding_mean( 2 );
+    EXPECT_TRUE( std::isnan( mixed[ 0 ] ) );
+    EXPECT_EQ( mixed[ 1 ], -inf );
+    EXPECT_EQ( mixed[ 2 ], 4.0 );
+
+    auto ticks = List<Tick>( { { 1, 10.0 }, { 2, 12.0 }, { 3, 11.0 }, { 4, 15.0 } } );
+    EXPECT_EQ( ticks.sliding_max( &Tick::price, 2 ), List<double>( { 12.0, 12.0, 15.0 } ) );
+    EXPECT_EQ( ticks.sliding_mean( &Tick::price, 2 ), List<double>( { 11.0, 11.5, 13.0 } ) );
+}
+
+TEST( ListTimeWindows, BasicAssertions )
+{
+    auto ticks = List<Tick>( { { 1, 1.0 }, { 2, 2.0 }, { 5, 3.0 }, { 11, 4.0 }, { 12, 5.0 }, { 30, 6.0 } } );
+
+    auto tumbling = ticks.tumbling_window( &Tick::time, int64_t( 10 ) );
+    ASSERT_EQ( tumbling.size( ), 3 );
+    EXPECT_EQ( tumbling[ 0 ].start, 0 );
+    EXPECT_EQ( tumbling[ 0 ].end, 10 );
+    EXPECT_EQ( tumbling[ 0 ].elements.size( ), 3 );
+    EXPECT_EQ( tumbling[ 0 ].elements.data( ), ticks.data( ) );
+    EXPECT_EQ( tumbling[ 1 ].elements.size( ), 2 );
+    EXPECT_EQ( tumbling[ 2 ].start, 30 );
+
+    auto sliding = ticks.sliding_window( &Tick::time, int64_t( 10 ), int64_t( 5 ) );
+    auto starts = sliding.select<int64_t>( []( const auto &w ) { return w.start; } );
+    auto sizes = sliding.select<size_t>( []( const auto &w ) { return w.elements.size( ); } );
+    EXPECT_EQ( starts, List<int64_t>( { -5, 0, 5, 10, 25, 30 } ) );
+    EXPECT_EQ( sizes, List<size_t>( { 2, 3, 3, 2, 1, 1 } ) );
+
+    using namespace std::chrono;
+    using time = time_point<system_clock, seconds>;
+    auto events = List<time>( { time( 10s ), time( 50s ), time( 70s ), time( 200s ) } );
+    auto minutes = events.tumbling_window( []( time t ) { return t; }, seconds( 60 ) );
+    ASSERT_EQ( minutes.size( ), 3 );
+    EXPECT_EQ( minutes[ 1 ].start, time( 60s ) );
+    EXPECT_EQ( minutes[ 2 ].start, time( 180s ) );
+    EXPECT_EQ( minutes[ 0 ].elements.size( ), 2 );
+
+    EXPECT_TRUE( List<Tick>( ).tumbling_window( &Tick::time, int64_t( 10 ) ).empty( ) );
+    EXPECT_THROW( ticks.tumbling_window( &Tick::time, int64_t( 0 ) ), std::invalid_argument );
+    auto unordered = List<Tick>( { { 5, 1.0 }, { 1, 1.0 } } );
+    EXPECT_THROW( unordered.tumbling_window( &Tick::time, int64_t( 10 ) ), std::invalid_argument );
+}